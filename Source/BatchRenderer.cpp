@@ -0,0 +1,341 @@
+/*
+  ==============================================================================
+
+    BatchRenderer.cpp
+    Created: 19 Oct 2026 8:31:12pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#include "BatchRenderer.h"
+#include "PluginProcessor.h"
+
+#include <iostream>
+
+//==============================================================================
+static void setParameter (FractureAudioProcessor& processor, const juce::String& id, float value)
+{
+    if (auto* parameter = processor.apvts.getParameter (id))
+        parameter->setValueNotifyingHost (parameter->convertTo0to1 (value));
+}
+
+BatchRenderer::BatchRenderer (Options options)
+    : m_options (options)
+{
+}
+
+juce::Result BatchRenderer::loadSettings()
+{
+    m_presetState.reset();
+    m_automation.clear();
+
+    // A preset's parameter IDs are checked with the automation's; a saved state skips unknown ones
+    juce::Array<ParameterChange> presetChanges;
+
+    if (m_options.preset != juce::File())
+    {
+        if (! m_options.preset.existsAsFile())
+            return juce::Result::fail ("No preset at " + m_options.preset.getFullPathName());
+
+        juce::NamedValueSet values;
+        m_options.preset.loadFileAsData (m_presetState);
+
+        // The plugin state, binary or as <PARAMETERS><PARAM id="..." value="..."/>...</PARAMETERS>,
+        // goes to the processor as it is
+        if (StateRecall::parse (m_presetState.getData(), m_presetState.getSize(), values))
+        {
+            juce::MemoryBlock path;
+
+            if (StateRecall::findChunk (m_presetState.getData(), m_presetState.getSize(), StateRecall::impulseChunk, path)
+                && m_options.impulse == juce::File() && ! juce::File (path.toString()).existsAsFile())
+                return juce::Result::fail ("No impulse response at " + path.toString());
+        }
+        else
+        {
+            juce::StringArray lines;
+            m_options.preset.readLines (lines);
+
+            for (auto& line : lines)
+            {
+                auto tokens = juce::StringArray::fromTokens (line.upToFirstOccurrenceOf ("#", false, false), " \t=", {});
+                tokens.removeEmptyStrings();
+
+                if (tokens.size() == 0)
+                    continue;
+
+                if (tokens.size() != 2)
+                    return juce::Result::fail ("Bad preset line: " + line);
+
+                presetChanges.add ({ 0.0, tokens[0], tokens[1].getFloatValue() });
+                values.set (tokens[0], tokens[1].getFloatValue());
+            }
+
+            // Lines of "ID value" become a state like any other
+            m_presetState.reset();
+            StateRecall::write (values, m_presetState);
+        }
+    }
+
+    if (m_options.impulse != juce::File() && ! m_options.impulse.existsAsFile())
+        return juce::Result::fail ("No impulse response at " + m_options.impulse.getFullPathName());
+
+    if (m_options.automation != juce::File())
+    {
+        if (! m_options.automation.existsAsFile())
+            return juce::Result::fail ("No automation file at " + m_options.automation.getFullPathName());
+
+        juce::StringArray lines;
+        m_options.automation.readLines (lines);
+
+        for (auto& line : lines)
+        {
+            auto tokens = juce::StringArray::fromTokens (line.upToFirstOccurrenceOf ("#", false, false), ",", {});
+            tokens.trim();
+            tokens.removeEmptyStrings();
+
+            if (tokens.size() == 0)
+                continue;
+
+            if (tokens.size() != 3 || ! tokens[0].containsOnly ("0123456789.eE+-"))
+                return juce::Result::fail ("Bad automation line: " + line);
+
+            m_automation.add ({ tokens[0].getDoubleValue(), tokens[1], tokens[2].getFloatValue() });
+        }
+
+        // Stable, so changes at the same time apply in file order
+        std::stable_sort (m_automation.begin(), m_automation.end(),
+                          [] (const ParameterChange& a, const ParameterChange& b) { return a.seconds < b.seconds; });
+    }
+
+    // Catch a misspelt ID here rather than once per file
+    FractureAudioProcessor processor;
+
+    for (auto* changes : { &presetChanges, &m_automation })
+        for (auto& change : *changes)
+            if (processor.apvts.getParameter (change.parameterID) == nullptr)
+                return juce::Result::fail ("Unknown parameter " + change.parameterID);
+
+    return juce::Result::ok();
+}
+
+juce::Array<juce::File> BatchRenderer::findInputFiles (const juce::Array<juce::File>& filesAndDirectories) const
+{
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    auto wildcard = formats.getWildcardForAllFormats();
+    juce::Array<juce::File> inputs;
+
+    for (auto& file : filesAndDirectories)
+    {
+        if (file.isDirectory())
+        {
+            for (const auto& entry : juce::RangedDirectoryIterator (file, true, wildcard, juce::File::findFiles))
+                inputs.addIfNotAlreadyThere (entry.getFile());
+        }
+        else
+        {
+            inputs.addIfNotAlreadyThere (file);
+        }
+    }
+
+    // Leave earlier output in place rather than rendering it a second time
+    inputs.removeIf ([this] (const juce::File& file)
+                     { return m_options.suffix.isNotEmpty() && file.getFileNameWithoutExtension().endsWith (m_options.suffix); });
+
+    return inputs;
+}
+
+juce::File BatchRenderer::getOutputFile (const juce::File& input) const
+{
+    auto directory = m_options.outputDirectory != juce::File() ? m_options.outputDirectory
+                                                               : input.getParentDirectory();
+
+    return directory.getChildFile (input.getFileNameWithoutExtension() + m_options.suffix + input.getFileExtension());
+}
+
+//==============================================================================
+juce::Array<BatchRenderer::Result> BatchRenderer::renderAll (const juce::Array<juce::File>& inputs)
+{
+    auto numThreads = m_options.numThreads > 0 ? m_options.numThreads : juce::SystemStats::getNumCpus();
+    numThreads = juce::jlimit (1, juce::jmax (1, inputs.size()), numThreads);
+
+    juce::Array<Result> results;
+    results.resize (inputs.size());
+
+    juce::CriticalSection reportLock;
+    juce::WaitableEvent finished;
+    int numRemaining = inputs.size();
+    juce::ThreadPool pool (numThreads);
+
+    for (int i = 0; i < inputs.size(); ++i)
+    {
+        pool.addJob ([this, i, &inputs, &results, &reportLock, &finished, &numRemaining]
+        {
+            auto result = render (inputs.getReference (i));
+
+            const juce::ScopedLock sl (reportLock);
+            results.setUnchecked (i, result);
+
+            if (result.wasOk())
+                std::cout << result.output.getFullPathName() << ": "
+                          << juce::String (result.audioSeconds, 1) << " s of audio in "
+                          << juce::String (result.renderSeconds, 2) << " s ("
+                          << juce::String (result.audioSeconds / juce::jmax (1.0e-6, result.renderSeconds), 0) << "x)" << std::endl;
+            else
+                std::cout << result.input.getFullPathName() << ": " << result.error << std::endl;
+
+            // The last job to finish wakes the caller
+            if (--numRemaining == 0)
+                finished.signal();
+        });
+    }
+
+    if (inputs.size() > 0)
+        finished.wait();
+
+    return results;
+}
+
+BatchRenderer::Result BatchRenderer::render (const juce::File& input) const
+{
+    Result result;
+    result.input = input;
+    result.output = getOutputFile (input);
+
+    auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    auto fail = [&result] (const juce::String& error)
+    {
+        result.error = error;
+        return result;
+    };
+
+    if (result.output == input)
+        return fail ("Would overwrite the input: set a suffix or another output directory");
+
+    // One of everything per job: nothing here is shared with another worker
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader (formats.createReaderFor (input));
+
+    if (reader == nullptr)
+        return fail ("Not a readable audio file");
+
+    auto numChannels = static_cast<int> (reader->numChannels);
+    auto sampleRate = reader->sampleRate;
+    auto channelSet = SpeakerLayout::getDefaultChannelSet (numChannels);
+
+    if (channelSet.size() != numChannels || ! SpeakerLayout::isSupported (channelSet))
+        return fail (juce::String (numChannels) + " channels is not a supported layout");
+
+    auto* format = formats.findFormatForFileExtension (result.output.getFileExtension());
+
+    if (format == nullptr)
+        return fail ("No writer for " + result.output.getFileExtension());
+
+    // Keep the source resolution where the format can hold it
+    auto bitsPerSample = static_cast<int> (reader->bitsPerSample);
+
+    if (! format->getPossibleBitDepths().contains (bitsPerSample))
+        bitsPerSample = format->getPossibleBitDepths().contains (24) ? 24 : format->getPossibleBitDepths().getLast();
+
+    if (! result.output.getParentDirectory().createDirectory())
+        return fail ("Could not create " + result.output.getParentDirectory().getFullPathName());
+
+    // Written next to the target and moved into place once complete, so a
+    // failed render never leaves half a file behind
+    juce::TemporaryFile temporary (result.output);
+    std::unique_ptr<juce::OutputStream> stream (temporary.getFile().createOutputStream());
+    std::unique_ptr<juce::AudioFormatWriter> writer;
+
+    if (stream != nullptr)
+        writer.reset (format->createWriterFor (stream.get(), sampleRate, static_cast<unsigned int> (numChannels),
+                                               bitsPerSample, reader->metadataValues, 0));
+
+    if (writer == nullptr)
+        return fail ("Could not write " + temporary.getFile().getFullPathName());
+
+    stream.release();   // now owned by the writer
+
+    //==============================================================================
+    FractureAudioProcessor processor;
+
+    juce::AudioProcessor::BusesLayout layout;
+    layout.inputBuses.add (channelSet);
+    layout.outputBuses.add (channelSet);
+    processor.setBusesLayout (layout);
+    processor.setNonRealtime (true);
+
+    // Settings that are in place before prepareToPlay start without a glide
+    auto chunkSize = juce::jmax (1, m_options.chunkSize);
+    int nextChange = 0;
+
+    // Through the same recall as the plugin's, impulse response chunk and all; the
+    // processor isn't playing yet, so it applies at once
+    if (! m_presetState.isEmpty())
+        processor.setStateInformation (m_presetState.getData(), static_cast<int> (m_presetState.getSize()));
+
+    if (m_options.impulse != juce::File())
+    {
+        auto loaded = processor.loadImpulseResponse (m_options.impulse);
+
+        if (loaded.failed())
+            return fail (loaded.getErrorMessage());
+    }
+
+    for (; nextChange < m_automation.size() && m_automation.getReference (nextChange).seconds <= 0.0; ++nextChange)
+        setParameter (processor, m_automation.getReference (nextChange).parameterID, m_automation.getReference (nextChange).value);
+
+    processor.setRateAndBufferSizeDetails (sampleRate, chunkSize);
+    processor.prepareToPlay (sampleRate, chunkSize);
+
+    juce::AudioBuffer<float> buffer (numChannels, chunkSize);
+    juce::MidiBuffer midi;
+
+    auto inputLength = reader->lengthInSamples;
+    auto totalLength = inputLength + static_cast<juce::int64> (juce::jmax (0.0, m_options.tailSeconds) * sampleRate);
+
+    for (juce::int64 position = 0; position < totalLength;)
+    {
+        auto numSamples = static_cast<int> (juce::jmin (static_cast<juce::int64> (chunkSize), totalLength - position));
+
+        // A chunk ends at the next automation point, so every change lands on its sample
+        if (nextChange < m_automation.size())
+        {
+            auto changePosition = static_cast<juce::int64> (m_automation.getReference (nextChange).seconds * sampleRate);
+
+            if (changePosition > position)
+                numSamples = static_cast<int> (juce::jmin (static_cast<juce::int64> (numSamples), changePosition - position));
+        }
+
+        // Reads past the end of the file come back as silence, which renders the tail
+        juce::AudioBuffer<float> chunk (buffer.getArrayOfWritePointers(), numChannels, numSamples);
+
+        if (! reader->read (&chunk, 0, numSamples, position, true, true))
+            return fail ("Read failed at sample " + juce::String (position));
+
+        processor.processBlock (chunk, midi);
+
+        if (! writer->writeFromAudioSampleBuffer (chunk, 0, numSamples))
+            return fail ("Write failed at sample " + juce::String (position));
+
+        position += numSamples;
+
+        for (; nextChange < m_automation.size()
+                 && static_cast<juce::int64> (m_automation.getReference (nextChange).seconds * sampleRate) <= position; ++nextChange)
+            setParameter (processor, m_automation.getReference (nextChange).parameterID, m_automation.getReference (nextChange).value);
+    }
+
+    processor.releaseResources();
+    writer.reset();     // flushes and closes the stream
+
+    if (! temporary.overwriteTargetFileWithTemporary())
+        return fail ("Could not move the render to " + result.output.getFullPathName());
+
+    result.audioSeconds = static_cast<double> (totalLength) / sampleRate;
+    result.renderSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    return result;
+}
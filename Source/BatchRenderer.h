@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    BatchRenderer.h
+    Created: 19 Oct 2026 8:31:12pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Renders audio files through FractureAudioProcessor offline, as fast as
+    the machine allows.
+
+    Files are spread over a thread pool. Every job owns its own processor,
+    reader and writer, so workers share nothing but the settings. Each file
+    is streamed through in chunks, so a long stem never has to fit in memory.
+
+    Settings are a preset (a saved plugin state, the parameter XML, or lines
+    of "ID value") and an optional automation file with one change per line:
+    "seconds,ID,value", in the parameter's own units. The preset is recalled
+    the way the plugin recalls a state, so any parameter it leaves out gets
+    its default. The smear's impulse response comes from its own file, or
+    from the preset's.
+*/
+class BatchRenderer
+{
+public:
+    struct Options
+    {
+        juce::File outputDirectory;             // next to each input when not set
+        juce::String suffix = "_fracture";      // added to the output file names
+        juce::File preset;
+        juce::File automation;
+        juce::File impulse;                     // the smear's impulse response; otherwise the preset's, if it has one
+        int numThreads = 0;                     // 0 uses every core
+        int chunkSize = 4096;                   // samples read, processed and written at a time
+        double tailSeconds = 0.0;               // silence rendered after the input to let the repeats ring out
+    };
+
+    struct Result
+    {
+        juce::File input, output;
+        juce::String error;                     // empty on success
+        double audioSeconds = 0.0;
+        double renderSeconds = 0.0;
+
+        bool wasOk() const noexcept             { return error.isEmpty(); }
+    };
+
+    explicit BatchRenderer (Options options);
+
+    /** Reads the preset and automation files. Must succeed before rendering. */
+    juce::Result loadSettings();
+
+    /** Expands directories into the audio files they contain. */
+    juce::Array<juce::File> findInputFiles (const juce::Array<juce::File>& filesAndDirectories) const;
+
+    /** Renders every file on the thread pool, reporting each one as it finishes. */
+    juce::Array<Result> renderAll (const juce::Array<juce::File>& inputs);
+
+    /** Renders one file on the calling thread. */
+    Result render (const juce::File& input) const;
+
+private:
+    struct ParameterChange
+    {
+        double seconds = 0.0;
+        juce::String parameterID;
+        float value = 0.0f;
+    };
+
+    juce::File getOutputFile (const juce::File& input) const;
+
+    Options m_options;
+    juce::MemoryBlock m_presetState;                // as the plugin would be given it
+    juce::Array<ParameterChange> m_automation;      // sorted by time
+
+    JUCE_DECLARE_NON_COPYABLE (BatchRenderer)
+};
@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+    CoefficientWorker.cpp
+    Created: 21 Oct 2026 2:18:55pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#include "CoefficientWorker.h"
+
+//==============================================================================
+CoefficientWorker::CoefficientWorker (juce::AudioProcessorValueTreeState& apvts)
+    : juce::Thread ("Fracture coefficients"),
+      m_apvts (apvts),
+      m_lowCut (apvts.getRawParameterValue ("LOWCUT")),
+      m_highCut (apvts.getRawParameterValue ("HIGHCUT"))
+{
+    jassert (m_lowCut != nullptr && m_highCut != nullptr);
+
+    m_current = build().release();
+
+    m_apvts.addParameterListener ("LOWCUT", this);
+    m_apvts.addParameterListener ("HIGHCUT", this);
+}
+
+CoefficientWorker::~CoefficientWorker()
+{
+    m_apvts.removeParameterListener ("LOWCUT", this);
+    m_apvts.removeParameterListener ("HIGHCUT", this);
+
+    stopThread (1000);
+    delete m_current.load();
+}
+
+void CoefficientWorker::prepare (double sampleRate, bool isRealtime)
+{
+    // The audio thread is stopped, so every replaced set can go now
+    stopThread (1000);
+
+    m_sampleRate = sampleRate;
+    m_isRealtime = isRealtime;
+    publish (build());
+    reclaim (true);
+
+    if (m_isRealtime)
+        startThread (juce::Thread::Priority::low);
+}
+
+void CoefficientWorker::setRealtime (bool isRealtime)
+{
+    if (isRealtime == m_isRealtime.load())
+        return;
+
+    if (isRealtime)
+    {
+        {
+            const juce::ScopedLock sl (m_offlineLock);
+            m_isRealtime = true;
+        }
+
+        startThread (juce::Thread::Priority::low);
+    }
+    else
+    {
+        // The worker has to be gone before the audio thread starts building
+        stopThread (1000);
+        m_isRealtime = false;
+    }
+}
+
+void CoefficientWorker::update()
+{
+    if (m_isRealtime.load())
+        return;
+
+    // Offline the caller is the only reader, and it isn't holding a set between blocks
+    const juce::ScopedLock sl (m_offlineLock);
+
+    if (! m_isRealtime.load() && isOutOfDate())
+    {
+        publish (build());
+        reclaim (true);
+    }
+}
+
+//==============================================================================
+void CoefficientWorker::run()
+{
+    while (! threadShouldExit())
+    {
+        if (isOutOfDate())
+            publish (build());
+
+        reclaim (false);
+
+        // Sets still waiting for the audio thread to move on are checked on again;
+        // otherwise nothing happens until a parameter changes
+        wait (m_retired.empty() ? -1 : reclaimIntervalMs);
+    }
+}
+
+void CoefficientWorker::parameterChanged (const juce::String&, float)
+{
+    // Hosts can move parameters from more than one thread
+    m_generation.fetch_add (1);
+    notify();
+}
+
+bool CoefficientWorker::isOutOfDate() const noexcept
+{
+    auto& current = *m_current.load (std::memory_order_relaxed);
+
+    // A parameter that moved and came back still gets a set of the new generation
+    return current.generation != m_generation.load (std::memory_order_relaxed)
+        || current.sampleRate != m_sampleRate
+        || current.lowCutHz != m_lowCut->load (std::memory_order_relaxed)
+        || current.highCutHz != m_highCut->load (std::memory_order_relaxed);
+}
+
+std::unique_ptr<CoefficientSet> CoefficientWorker::build() const
+{
+    // The generation is read first: the parameters it counts are already in place,
+    // and a change that lands after it only makes the set look older than it is
+    auto set = std::make_unique<CoefficientSet>();
+    set->generation = m_generation.load();
+    set->sampleRate = m_sampleRate;
+    set->lowCutHz = m_lowCut->load (std::memory_order_relaxed);
+    set->highCutHz = m_highCut->load (std::memory_order_relaxed);
+    set->floatTone = FeedbackFilter<float>::design (m_sampleRate, set->lowCutHz, set->highCutHz);
+    set->doubleTone = FeedbackFilter<double>::design (m_sampleRate, set->lowCutHz, set->highCutHz);
+    return set;
+}
+
+void CoefficientWorker::publish (std::unique_ptr<CoefficientSet> set)
+{
+    std::unique_ptr<const CoefficientSet> previous (m_current.exchange (set.release()));
+    m_retired.push_back ({ std::move (previous), m_readerEpoch.load() });
+}
+
+void CoefficientWorker::reclaim (bool readerIsIdle)
+{
+    auto epoch = m_readerEpoch.load();
+
+    m_retired.erase (std::remove_if (m_retired.begin(), m_retired.end(),
+                                     [epoch, readerIsIdle] (const Retired& retired)
+                                     {
+                                         return readerIsIdle || retired.epoch != epoch;
+                                     }),
+                     m_retired.end());
+}
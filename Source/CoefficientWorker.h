@@ -0,0 +1,132 @@
+/*
+  ==============================================================================
+
+    CoefficientWorker.h
+    Created: 21 Oct 2026 2:18:55pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FeedbackFilter.h"
+
+//==============================================================================
+/** Everything derived from the parameters that is too slow to build on the
+    audio thread. Never changed once published.
+*/
+struct CoefficientSet
+{
+    double sampleRate = 44100.0;
+    float lowCutHz = 0.0f, highCutHz = 0.0f;
+    juce::uint32 generation = 0;            // the parameter changes it has seen; see CoefficientWorker
+    FeedbackFilter<float>::Design floatTone;
+    FeedbackFilter<double>::Design doubleTone;
+
+    template <typename SampleType>
+    const typename FeedbackFilter<SampleType>::Design& getTone() const noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, float>)
+            return floatTone;
+        else
+            return doubleTone;
+    }
+};
+
+//==============================================================================
+/**
+    Rebuilds the CoefficientSet on its own thread whenever the parameters it
+    depends on change, and hands it to the audio thread read-copy-update
+    style.
+
+    The worker sleeps until a parameter it depends on changes: the
+    parameter listener only wakes it. A new set replaces the current one
+    with a single atomic exchange. The audio
+    thread loads the pointer once at the start of a block with acquire()
+    and calls release() at the end, which only bumps a counter. A replaced
+    set is freed by the worker once that counter has moved on, because by
+    then the block that might have been reading it is over; while any are
+    waiting, the worker checks back every reclaimIntervalMs.
+
+    A non-realtime (offline) processor has no worker thread: it calls
+    update() at the start of each block instead, so parameter changes land
+    on the same block on every render. The host can switch between the two
+    without preparing again, through setRealtime().
+*/
+class CoefficientWorker  : private juce::Thread,
+                           private juce::AudioProcessorValueTreeState::Listener
+{
+public:
+    explicit CoefficientWorker (juce::AudioProcessorValueTreeState& apvts);
+    ~CoefficientWorker() override;
+
+    /** Builds a set for the sample rate and starts the worker thread, unless
+        offline. Not real-time safe, and not to be called while processing.
+    */
+    void prepare (double sampleRate, bool isRealtime);
+
+    /** Starts or stops the worker when the host switches to or from offline
+        rendering. Not real-time safe; may be called while processing.
+    */
+    void setRealtime (bool isRealtime);
+
+    //==============================================================================
+    // Audio thread
+    const CoefficientSet& acquire() const noexcept     { return *m_current.load(); }
+    void release() noexcept                            { m_readerEpoch.store (m_readerEpoch.load (std::memory_order_relaxed) + 1); }
+
+    /** Offline, rebuilds the set right away if the parameters moved; otherwise does nothing. */
+    void update();
+
+    /** Counts the changes to the parameters the set depends on. Any thread. */
+    juce::uint32 getGeneration() const noexcept        { return m_generation.load(); }
+
+    /** True once the published set was built from the parameters as they were
+        at the given generation, or later.
+    */
+    bool hasBuilt (juce::uint32 generation) const noexcept
+    {
+        return static_cast<juce::int32> (m_current.load()->generation - generation) >= 0;
+    }
+
+private:
+    void run() override;
+    void parameterChanged (const juce::String& parameterID, float newValue) override;
+
+    bool isOutOfDate() const noexcept;
+    std::unique_ptr<CoefficientSet> build() const;
+    void publish (std::unique_ptr<CoefficientSet> set);
+    void reclaim (bool readerIsIdle);
+
+    static constexpr int reclaimIntervalMs = 20;
+
+    juce::AudioProcessorValueTreeState& m_apvts;
+    std::atomic<float>* m_lowCut;
+    std::atomic<float>* m_highCut;
+    std::atomic<juce::uint32> m_generation { 0 };
+    double m_sampleRate = 44100.0;
+
+    // Offline, the audio thread builds under m_offlineLock. Switching to realtime takes
+    // the lock, so the worker never starts while an offline update() is still going
+    std::atomic<bool> m_isRealtime { true };
+    juce::CriticalSection m_offlineLock;
+
+    // The pointer and the reader's counter are sequentially consistent: a worker that
+    // swapped the pointer and then reads the counter sees at least the value the audio
+    // thread had stored before it loaded the old pointer
+    std::atomic<const CoefficientSet*> m_current { nullptr };
+    std::atomic<juce::uint64> m_readerEpoch { 0 };
+
+    // Replaced sets and the reader's counter when they were replaced; worker side only
+    struct Retired
+    {
+        std::unique_ptr<const CoefficientSet> set;
+        juce::uint64 epoch;
+    };
+
+    std::vector<Retired> m_retired;
+
+    JUCE_DECLARE_NON_COPYABLE (CoefficientWorker)
+};
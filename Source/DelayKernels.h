@@ -0,0 +1,534 @@
+/*
+  ==============================================================================
+
+    DelayKernels.h
+    Created: 18 Oct 2026 11:25:48am
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*  The kernels are compiled once per instruction set (see KernelDispatch.h).
+    Each variant's translation unit names its own FRACTURE_KERNEL_ISA, which
+    puts its copies in their own namespace so the linker can never swap an
+    AVX2 copy in for the baseline one. Nothing but the C library and the
+    intrinsics may be included here: any shared inline function pulled into
+    a variant would carry the same risk.
+*/
+#ifndef FRACTURE_KERNEL_ISA
+ #define FRACTURE_KERNEL_ISA baseline
+#endif
+
+#include <cstring>
+
+/*  The half-precision conversions use F16C in the variants built for it.
+    GCC and Clang only define __F16C__ for -mf16c, which -mavx2 doesn't
+    imply; MSVC has no such macro, but every CPU with AVX2 has F16C.
+*/
+#if (defined (__x86_64__) || defined (_M_X64) || defined (__i386__) || defined (_M_IX86)) \
+     && (defined (__F16C__) || (defined (_MSC_VER) && defined (__AVX2__)))
+ #include <immintrin.h>
+ #define FRACTURE_USE_F16C 1
+#else
+ #define FRACTURE_USE_F16C 0
+#endif
+
+/*  The scalar variant keeps the compiler from vectorising the loops, as the
+    reference the other variants are measured against.
+*/
+#if defined (FRACTURE_KERNEL_SCALAR) && defined (_MSC_VER) && ! defined (__clang__)
+ #define FRACTURE_NO_VECTORIZE __pragma (loop (no_vector))
+#elif defined (FRACTURE_KERNEL_SCALAR) && defined (__clang__)
+ #define FRACTURE_NO_VECTORIZE _Pragma ("clang loop vectorize(disable) interleave(disable)")
+#else
+ #define FRACTURE_NO_VECTORIZE
+#endif
+
+/** Fractional read modes of the delay line, in the order of the INTERP parameter. */
+enum class Interpolation
+{
+    linear,
+    lagrange3,
+    hermite
+};
+
+namespace DelayKernels
+{
+inline namespace FRACTURE_KERNEL_ISA
+{
+    /** Fused read-mix-write pass over one contiguous span of a channel.
+
+        For every sample the delayed signal is added to the input in place,
+        and the input plus the feedback-scaled output is written back into the
+        delay line:
+
+            y[i]     = x[i] + wetGain[i] * delayRead[i]
+            write[i] = x[i] + feedback[i] * y[i]
+
+        The caller guarantees that the read and write spans don't overlap
+        (numSamples <= delay in samples), which is what lets the compiler
+        treat the pointers as restrict and vectorise the loop.
+
+        SampleType is float or double; the parameter ramps are always float.
+    */
+    template <typename SampleType>
+    inline void readMixWrite (SampleType* __restrict io,
+                              SampleType* __restrict delayWrite,
+                              const SampleType* __restrict delayRead,
+                              const float* __restrict wetGain,
+                              const float* __restrict feedback,
+                              int numSamples) noexcept
+    {
+        FRACTURE_NO_VECTORIZE
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto x = io[i];
+            auto y = x + static_cast<SampleType> (wetGain[i]) * delayRead[i];
+            io[i] = y;
+            delayWrite[i] = x + static_cast<SampleType> (feedback[i]) * y;
+        }
+    }
+
+    /** readMixWrite for a stereo pair whose delay line stores interleaved
+        frames: both channels are written back as one contiguous stream of
+        L/R pairs, and the shared gain and feedback ramps are read once.
+    */
+    template <typename SampleType>
+    inline void readMixWriteStereo (SampleType* __restrict ioLeft,
+                                    SampleType* __restrict ioRight,
+                                    SampleType* __restrict delayWriteFrames,
+                                    const SampleType* __restrict delayReadLeft,
+                                    const SampleType* __restrict delayReadRight,
+                                    const float* __restrict wetGain,
+                                    const float* __restrict feedback,
+                                    int numSamples) noexcept
+    {
+        FRACTURE_NO_VECTORIZE
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto gain = static_cast<SampleType> (wetGain[i]);
+            auto amount = static_cast<SampleType> (feedback[i]);
+            auto left = ioLeft[i], right = ioRight[i];
+            auto wetLeft = left + gain * delayReadLeft[i];
+            auto wetRight = right + gain * delayReadRight[i];
+            ioLeft[i] = wetLeft;
+            ioRight[i] = wetRight;
+            delayWriteFrames[2 * i] = left + amount * wetLeft;
+            delayWriteFrames[2 * i + 1] = right + amount * wetRight;
+        }
+    }
+
+    /** Adds a wet signal into the dry one in place, io[i] += wetGain[i] * wet[i]. */
+    template <typename SampleType>
+    inline void mixWet (SampleType* __restrict io,
+                        const SampleType* __restrict wet,
+                        const float* __restrict wetGain,
+                        int numSamples) noexcept
+    {
+        FRACTURE_NO_VECTORIZE
+        for (int i = 0; i < numSamples; ++i)
+            io[i] += static_cast<SampleType> (wetGain[i]) * wet[i];
+    }
+
+    /** One butterfly of the Hadamard transform below: a, b become a + b, a - b. */
+    template <typename SampleType>
+    inline void butterfly (SampleType* __restrict a, SampleType* __restrict b, int numSamples) noexcept
+    {
+        FRACTURE_NO_VECTORIZE
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto sum = a[i] + b[i];
+            b[i] = a[i] - b[i];
+            a[i] = sum;
+        }
+    }
+
+    /** Mixes numLines signals (a power of two) through an unnormalised
+        Hadamard matrix, in place: log2 (numLines) rounds of butterflies
+        instead of a dense matrix multiply. Every butterfly runs along the
+        block, so the vectors fill with consecutive samples of one pair of
+        lines rather than with the lines of one sample. Scaling by
+        1 / sqrt (numLines) makes it orthogonal; that is left to the caller.
+    */
+    template <typename SampleType>
+    inline void hadamard (SampleType* const* lines, int numLines, int numSamples) noexcept
+    {
+        for (int half = 1; half < numLines; half *= 2)
+            for (int start = 0; start < numLines; start += 2 * half)
+                for (int line = start; line < start + half; ++line)
+                    butterfly (lines[line], lines[line + half], numSamples);
+    }
+
+    /** Adds the product of two spectra to an accumulator, accumulator[k] +=
+        a[k] * b[k], over numBins complex bins. The bins are interleaved real
+        and imaginary parts, as juce::dsp::FFT's real-only transforms leave
+        them, so nothing has to be reshuffled between transform and multiply.
+    */
+    template <typename SampleType>
+    inline void complexMultiplyAdd (SampleType* __restrict accumulator,
+                                    const SampleType* __restrict a,
+                                    const SampleType* __restrict b,
+                                    int numBins) noexcept
+    {
+        FRACTURE_NO_VECTORIZE
+        for (int i = 0; i < numBins; ++i)
+        {
+            auto aReal = a[2 * i], aImag = a[2 * i + 1];
+            auto bReal = b[2 * i], bImag = b[2 * i + 1];
+            accumulator[2 * i] += aReal * bReal - aImag * bImag;
+            accumulator[2 * i + 1] += aReal * bImag + aImag * bReal;
+        }
+    }
+
+    //==============================================================================
+    /** Fetches the four neighbours of each fractional position from a straight
+        window of the delay line, as separate arrays so that the interpolation
+        below can run across several output samples per instruction.
+
+        Consecutive samples of the window are stride apart (1 for a planar
+        ring). Every position must lie in [1, windowLength - 3).
+    */
+    template <typename SampleType>
+    inline void gatherTaps (const SampleType* __restrict window,
+                            int stride,
+                            const SampleType* __restrict positions,
+                            SampleType* __restrict before,
+                            SampleType* __restrict at,
+                            SampleType* __restrict after,
+                            SampleType* __restrict afterNext,
+                            SampleType* __restrict fraction,
+                            int numSamples) noexcept
+    {
+        FRACTURE_NO_VECTORIZE
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto index = static_cast<int> (positions[i]);
+            fraction[i] = positions[i] - static_cast<SampleType> (index);
+            before[i] = window[(index - 1) * stride];
+            at[i] = window[index * stride];
+            after[i] = window[(index + 1) * stride];
+            afterNext[i] = window[(index + 2) * stride];
+        }
+    }
+
+    //==============================================================================
+    /** Channels per frame of a laned delay line (DelayLayout::laned): a bus
+        wider than stereo is stored and processed in groups of this many
+        channels, one sample of each to a vector. Lanes past the last channel
+        are silent.
+    */
+    constexpr int channelLanes = 8;
+
+    /** Packs numSamples of up to channelLanes planar channels into frames,
+        and zeroes the lanes past numChannels.
+    */
+    template <typename SampleType>
+    inline void interleaveLanes (const SampleType* const* channels, int numChannels,
+                                 SampleType* __restrict frames, int numSamples) noexcept
+    {
+        for (int lane = 0; lane < channelLanes; ++lane)
+        {
+            if (lane < numChannels)
+            {
+                auto* __restrict source = channels[lane];
+
+                FRACTURE_NO_VECTORIZE
+                for (int i = 0; i < numSamples; ++i)
+                    frames[i * channelLanes + lane] = source[i];
+            }
+            else
+            {
+                FRACTURE_NO_VECTORIZE
+                for (int i = 0; i < numSamples; ++i)
+                    frames[i * channelLanes + lane] = 0;
+            }
+        }
+    }
+
+    /** Unpacks the first numChannels lanes of numSamples frames into planar channels. */
+    template <typename SampleType>
+    inline void deinterleaveLanes (const SampleType* __restrict frames, int numChannels,
+                                   SampleType* const* channels, int numSamples) noexcept
+    {
+        for (int lane = 0; lane < numChannels; ++lane)
+        {
+            auto* __restrict destination = channels[lane];
+
+            FRACTURE_NO_VECTORIZE
+            for (int i = 0; i < numSamples; ++i)
+                destination[i] = frames[i * channelLanes + lane];
+        }
+    }
+
+    /** gatherTaps for a window of laned frames: element i * channelLanes + lane
+        reads its own lane at its own position, so every channel of a group
+        can have a different delay and still be interpolated as one vector.
+    */
+    template <typename SampleType>
+    inline void gatherLanes (const SampleType* __restrict window,
+                             const SampleType* __restrict positions,
+                             SampleType* __restrict before,
+                             SampleType* __restrict at,
+                             SampleType* __restrict after,
+                             SampleType* __restrict afterNext,
+                             SampleType* __restrict fraction,
+                             int numFrames) noexcept
+    {
+        for (int i = 0; i < numFrames; ++i)
+        {
+            FRACTURE_NO_VECTORIZE
+            for (int lane = 0; lane < channelLanes; ++lane)
+            {
+                auto element = i * channelLanes + lane;
+                auto index = static_cast<int> (positions[element]);
+                auto* sample = window + index * channelLanes + lane;
+
+                fraction[element] = positions[element] - static_cast<SampleType> (index);
+                before[element] = sample[-channelLanes];
+                at[element] = sample[0];
+                after[element] = sample[channelLanes];
+                afterNext[element] = sample[2 * channelLanes];
+            }
+        }
+    }
+
+    /** readMixWrite over laned frames: every channel of a group is mixed and
+        written back in one vector per sample, with that sample's wet gain and
+        feedback for all of them.
+    */
+    template <typename SampleType>
+    inline void readMixWriteLanes (SampleType* __restrict io,
+                                   SampleType* __restrict delayWrite,
+                                   const SampleType* __restrict delayRead,
+                                   const float* __restrict wetGain,
+                                   const float* __restrict feedback,
+                                   int numFrames) noexcept
+    {
+        for (int i = 0; i < numFrames; ++i)
+        {
+            auto wet = static_cast<SampleType> (wetGain[i]);
+            auto back = static_cast<SampleType> (feedback[i]);
+            auto* frame = io + i * channelLanes;
+            auto* written = delayWrite + i * channelLanes;
+            auto* read = delayRead + i * channelLanes;
+
+            FRACTURE_NO_VECTORIZE
+            for (int lane = 0; lane < channelLanes; ++lane)
+            {
+                auto x = frame[lane];
+                auto y = x + wet * read[lane];
+                frame[lane] = y;
+                written[lane] = x + back * y;
+            }
+        }
+    }
+
+    //==============================================================================
+    /** Lanes per vector of the multi-tap engine's tap bank. */
+    constexpr int tapLanes = 8;
+
+    /** Sums taps packed sample by sample, tapLanes or a multiple of it to a
+        sample, each weighted by its lane's gain:
+
+            destination[i] = sum of gains[lane] * taps[i * numLanes + lane]
+
+        The lanes of one sample are summed in a fixed-width accumulator, so
+        eight taps cost one vector multiply-add and sixteen cost two.
+    */
+    template <typename SampleType>
+    inline void sumTaps (const SampleType* __restrict taps,
+                         const SampleType* __restrict gains,
+                         int numLanes,
+                         SampleType* __restrict destination,
+                         int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto* sample = taps + i * numLanes;
+            SampleType sums[tapLanes] = {};
+
+            for (int first = 0; first < numLanes; first += tapLanes)
+            {
+                FRACTURE_NO_VECTORIZE
+                for (int lane = 0; lane < tapLanes; ++lane)
+                    sums[lane] += gains[first + lane] * sample[first + lane];
+            }
+
+            auto total = static_cast<SampleType> (0);
+
+            for (int lane = 0; lane < tapLanes; ++lane)
+                total += sums[lane];
+
+            destination[i] = total;
+        }
+    }
+
+    /** Evaluates one interpolator over gathered taps. The loops carry no
+        dependencies between samples, so they vectorise across the block.
+    */
+    template <Interpolation type, typename SampleType>
+    inline void interpolate (const SampleType* __restrict before,
+                             const SampleType* __restrict at,
+                             const SampleType* __restrict after,
+                             const SampleType* __restrict afterNext,
+                             const SampleType* __restrict fraction,
+                             SampleType* __restrict destination,
+                             int numSamples) noexcept
+    {
+        constexpr auto one = static_cast<SampleType> (1), two = static_cast<SampleType> (2);
+        constexpr auto half = static_cast<SampleType> (0.5), sixth = one / static_cast<SampleType> (6);
+
+        FRACTURE_NO_VECTORIZE
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto t = fraction[i];
+
+            if constexpr (type == Interpolation::linear)
+            {
+                destination[i] = at[i] + t * (after[i] - at[i]);
+            }
+            else if constexpr (type == Interpolation::lagrange3)
+            {
+                auto tPlus1 = t + one, tMinus1 = t - one, tMinus2 = t - two;
+
+                destination[i] = -t * tMinus1 * tMinus2 * sixth * before[i]
+                                + tPlus1 * tMinus1 * tMinus2 * half * at[i]
+                                - tPlus1 * t * tMinus2 * half * after[i]
+                                + tPlus1 * t * tMinus1 * sixth * afterNext[i];
+            }
+            else
+            {
+                // 4-point, 3rd order Hermite (Catmull-Rom)
+                auto c1 = half * (after[i] - before[i]);
+                auto c2 = before[i] - static_cast<SampleType> (2.5) * at[i] + two * after[i] - half * afterNext[i];
+                auto c3 = half * (afterNext[i] - before[i]) + static_cast<SampleType> (1.5) * (at[i] - after[i]);
+
+                destination[i] = ((c3 * t + c2) * t + c1) * t + at[i];
+            }
+        }
+    }
+
+    //==============================================================================
+    /*  IEEE 754 binary16 conversion for the half-precision delay line (see
+        HalfFloat.h). The scalar routines and F16C give the same bits for every
+        input, NaNs included.
+    */
+    inline unsigned int halfToBits (float value) noexcept        { unsigned int bits; std::memcpy (&bits, &value, sizeof (bits)); return bits; }
+    inline float halfFromBits (unsigned int bits) noexcept       { float value; std::memcpy (&value, &bits, sizeof (value)); return value; }
+
+    /** Round to nearest even, subnormals kept, saturating at +-65504. A NaN stays
+        a quiet NaN with the top of its payload, as vcvtps2ph converts it.
+    */
+    inline unsigned short floatToHalf (float value) noexcept
+    {
+        constexpr unsigned int largestHalfAsFloat = 0x477fe000;                 // 65504
+        constexpr unsigned int smallestNormalHalfAsFloat = 113u << 23;          // 2^-14
+        constexpr unsigned int subnormalMagic = ((127 - 15) + (23 - 10) + 1) << 23;
+
+        auto bits = halfToBits (value);
+        auto sign = (bits >> 16) & 0x8000;
+        bits &= 0x7fffffff;
+
+        if (bits >= largestHalfAsFloat)
+            return static_cast<unsigned short> (sign | (bits > 0x7f800000 ? 0x7e00 | ((bits >> 13) & 0x3ff) : 0x7bff));
+
+        // Adding a magic number lets the FPU do the subnormal rounding
+        if (bits < smallestNormalHalfAsFloat)
+            return static_cast<unsigned short> (sign | (halfToBits (halfFromBits (bits) + halfFromBits (subnormalMagic)) - subnormalMagic));
+
+        auto mantissaOdd = (bits >> 13) & 1;
+        bits += (static_cast<unsigned int> (15 - 127) << 23) + 0xfff + mantissaOdd;
+        return static_cast<unsigned short> (sign | (bits >> 13));
+    }
+
+    inline float halfToFloat (unsigned short half) noexcept
+    {
+        constexpr unsigned int shiftedExponent = 0x7c00u << 13;
+
+        auto bits = static_cast<unsigned int> (half & 0x7fff) << 13;
+        auto exponent = bits & shiftedExponent;
+        bits += static_cast<unsigned int> (127 - 15) << 23;
+
+        if (exponent == shiftedExponent)
+        {
+            bits += static_cast<unsigned int> (128 - 16) << 23;         // infinity or NaN
+        }
+        else if (exponent == 0)
+        {
+            bits += 1u << 23;                                           // subnormal: renormalise
+            bits = halfToBits (halfFromBits (bits) - halfFromBits (113u << 23));
+        }
+
+        return halfFromBits (bits | (static_cast<unsigned int> (half & 0x8000) << 16));
+    }
+
+    // The contiguous float runs that F16C converts eight at a time; they return how many they did
+    inline int encodeHalfVectors (const float* source, unsigned short* destination, int numSamples) noexcept
+    {
+        int i = 0;
+
+       #if FRACTURE_USE_F16C
+        const auto limit = _mm256_set1_ps (65504.0f);
+        const auto negativeLimit = _mm256_set1_ps (-65504.0f);
+
+        // min and max return their second operand for a NaN, so the sample goes
+        // second and a NaN reaches the conversion as it is
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            auto values = _mm256_max_ps (negativeLimit, _mm256_min_ps (limit, _mm256_loadu_ps (source + i)));
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (destination + i),
+                              _mm256_cvtps_ph (values, _MM_FROUND_TO_NEAREST_INT));
+        }
+       #else
+        (void) source; (void) destination; (void) numSamples;
+       #endif
+
+        return i;
+    }
+
+    inline int decodeHalfVectors (const unsigned short* source, float* destination, int numSamples) noexcept
+    {
+        int i = 0;
+
+       #if FRACTURE_USE_F16C
+        for (; i + 8 <= numSamples; i += 8)
+            _mm256_storeu_ps (destination + i, _mm256_cvtph_ps (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (source + i))));
+       #else
+        (void) source; (void) destination; (void) numSamples;
+       #endif
+
+        return i;
+    }
+
+    inline int encodeHalfVectors (const double*, unsigned short*, int) noexcept    { return 0; }
+    inline int decodeHalfVectors (const unsigned short*, double*, int) noexcept    { return 0; }
+
+    /** Converts numSamples samples into half-precision samples stride apart. */
+    template <typename SampleType>
+    inline void encodeHalf (const SampleType* __restrict source,
+                            unsigned short* __restrict destination,
+                            int stride,
+                            int numSamples) noexcept
+    {
+        auto i = stride == 1 ? encodeHalfVectors (source, destination, numSamples) : 0;
+
+        for (; i < numSamples; ++i)
+            destination[i * stride] = floatToHalf (static_cast<float> (source[i]));
+    }
+
+    /** Converts numSamples half-precision samples, stride apart, back into samples. */
+    template <typename SampleType>
+    inline void decodeHalf (const unsigned short* __restrict source,
+                            int stride,
+                            SampleType* __restrict destination,
+                            int numSamples) noexcept
+    {
+        auto i = stride == 1 ? decodeHalfVectors (source, destination, numSamples) : 0;
+
+        for (; i < numSamples; ++i)
+            destination[i] = static_cast<SampleType> (halfToFloat (source[i * stride]));
+    }
+}
+}
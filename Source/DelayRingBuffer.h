@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+    DelayRingBuffer.h
+    Created: 18 Oct 2026 12:03:19pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DelayKernels.h"
+
+/** Sample layout of a DelayRingBuffer, shared by every storage format. */
+enum class DelayLayout
+{
+    planar,         // one contiguous run per channel
+    interleaved,    // one contiguous run of frames
+    laned           // one contiguous run of frames per group of DelayKernels::channelLanes channels
+};
+
+//==============================================================================
+/**
+    Multi-channel delay line storage with a power-of-two capacity.
+
+    Positions are wrapped with a mask instead of a modulo, and every channel
+    carries a mirrored guard region after its last sample: the first
+    getGuardSize() samples are duplicated there. Any read or write span of up
+    to getGuardSize() samples is therefore one straight run of memory starting
+    at the (masked) position, and never needs to be split at the wrap point.
+
+    After writing a span through getWritePointer(), call mirror() for it so
+    the duplicated samples stay in sync before anything reads them back.
+
+    The channels are planar by default. The interleaved layout stores whole
+    frames instead, so the samples of one channel are getStride() apart and
+    a stereo read or write touches one stream of cache lines rather than two.
+    The laned layout does the same for each group of
+    DelayKernels::channelLanes channels, with the spare lanes of the last
+    group left silent, so one sample of a whole group is one vector.
+
+    SampleType is the storage format: float, or HalfFloat::Bits for a line
+    that takes half the memory and is converted on the way in and out.
+*/
+template <typename SampleType>
+class DelayRingBuffer
+{
+public:
+    using Layout = DelayLayout;
+
+    DelayRingBuffer() = default;
+
+    /** Allocates at least minimumCapacity samples per channel, with room for
+        straight spans of up to maxSpanSize samples. Not real-time safe.
+    */
+    void setSize (int numChannels, int minimumCapacity, int maxSpanSize, Layout layout = Layout::planar)
+    {
+        m_guardSize = juce::jmax (1, maxSpanSize);
+        m_capacity = juce::nextPowerOfTwo (juce::jmax (minimumCapacity, 2 * m_guardSize));
+        m_mask = m_capacity - 1;
+        m_numChannels = numChannels;
+        m_layout = layout;
+
+        // Channels come in groups of m_stride, one frame of a group per position: a sample's
+        // address is (channel / m_stride) * m_groupStep + channel % m_stride + position * m_stride
+        auto channelLength = m_capacity + m_guardSize;
+        m_stride = layout == Layout::interleaved ? juce::jmax (1, numChannels)
+                                                 : layout == Layout::laned ? DelayKernels::channelLanes : 1;
+        m_groupStep = channelLength * m_stride;
+
+        auto numGroups = (juce::jmax (0, numChannels) + m_stride - 1) / m_stride;
+        m_numStoredSamples = static_cast<size_t> (m_groupStep) * static_cast<size_t> (numGroups);
+        m_storage.allocate (m_numStoredSamples, false);
+        clear();
+    }
+
+    /** Frees the storage. Not real-time safe. */
+    void release()
+    {
+        m_storage.free();
+        m_numStoredSamples = 0;
+        m_numChannels = 0;
+        m_writePosition = 0;
+    }
+
+    void clear() noexcept
+    {
+        std::fill (m_storage.get(), m_storage.get() + m_numStoredSamples, SampleType());
+        m_writePosition = 0;
+    }
+
+    int getNumChannels() const noexcept     { return m_numChannels; }
+    Layout getLayout() const noexcept       { return m_layout; }
+
+    /** Distance in samples between consecutive positions of one channel. */
+    int getStride() const noexcept          { return m_stride; }
+    int getCapacity() const noexcept        { return m_capacity; }
+    int getGuardSize() const noexcept       { return m_guardSize; }
+
+    /** Bytes held by the line, guard regions included. */
+    size_t getSizeInBytes() const noexcept  { return m_numStoredSamples * sizeof (SampleType); }
+
+    int wrap (int position) const noexcept  { return position & m_mask; }
+
+    //==============================================================================
+    /** Current write head, shared by all channels. */
+    int getWritePosition() const noexcept   { return m_writePosition; }
+
+    /** Position of the sample written delaySamples before the write head. */
+    int getReadPosition (int delaySamples) const noexcept
+    {
+        return wrap (m_writePosition - delaySamples);
+    }
+
+    /** Moves the write head on once every channel has been written for this block. */
+    void advance (int numSamples) noexcept
+    {
+        m_writePosition = wrap (m_writePosition + numSamples);
+    }
+
+    //==============================================================================
+    /** Start of a straight span of up to getGuardSize() samples at a wrapped
+        position. Consecutive samples of the span are getStride() apart.
+    */
+    SampleType* getWritePointer (int channel, int position) noexcept
+    {
+        jassert (position == wrap (position) && juce::isPositiveAndBelow (channel, m_numChannels));
+        return m_storage.get() + (channel / m_stride) * m_groupStep + channel % m_stride + position * m_stride;
+    }
+
+    const SampleType* getReadPointer (int channel, int position) const noexcept
+    {
+        jassert (position == wrap (position) && juce::isPositiveAndBelow (channel, m_numChannels));
+        return m_storage.get() + (channel / m_stride) * m_groupStep + channel % m_stride + position * m_stride;
+    }
+
+    /** Re-synchronises the guard region after numSamples were written at position. */
+    void mirror (int channel, int position, int numSamples) noexcept
+    {
+        jassert (numSamples <= m_guardSize);
+
+        auto* data = getWritePointer (channel, 0);
+        auto end = position + numSamples;
+
+        auto copy = [this, data] (int destination, int source, int count)
+        {
+            if (m_stride == 1)
+            {
+                std::copy (data + source, data + source + juce::jmax (0, count), data + destination);
+                return;
+            }
+
+            for (int i = 0; i < count; ++i)
+                data[(destination + i) * m_stride] = data[(source + i) * m_stride];
+        };
+
+        // The part that ran past the end belongs at the start...
+        copy (0, m_capacity, juce::jmax (0, end - m_capacity));
+
+        // ...and anything written at the start is duplicated into the guard
+        copy (m_capacity + position, position, juce::jmax (0, juce::jmin (end, m_guardSize) - position));
+    }
+
+    /** mirror() for whole frames: every channel of the group that starts at firstChannel. */
+    void mirrorFrames (int firstChannel, int position, int numSamples) noexcept
+    {
+        jassert (numSamples <= m_guardSize && firstChannel % m_stride == 0);
+
+        auto* data = getWritePointer (firstChannel, 0);
+        auto end = position + numSamples;
+
+        auto copy = [this, data] (int destination, int source, int count)
+        {
+            std::copy (data + source * m_stride, data + (source + juce::jmax (0, count)) * m_stride, data + destination * m_stride);
+        };
+
+        copy (0, m_capacity, juce::jmax (0, end - m_capacity));
+        copy (m_capacity + position, position, juce::jmax (0, juce::jmin (end, m_guardSize) - position));
+    }
+
+private:
+    juce::HeapBlock<SampleType> m_storage;
+    size_t m_numStoredSamples = 0;
+    int m_capacity = 0;
+    int m_mask = 0;
+    int m_guardSize = 0;
+    int m_writePosition = 0;
+    int m_numChannels = 0;
+    int m_stride = 1;
+    int m_groupStep = 0;
+    Layout m_layout = Layout::planar;
+
+    JUCE_DECLARE_NON_COPYABLE (DelayRingBuffer)
+};
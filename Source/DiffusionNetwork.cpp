@@ -0,0 +1,209 @@
+/*
+  ==============================================================================
+
+    DiffusionNetwork.cpp
+    Created: 23 Oct 2026 9:58:40am
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#include "DiffusionNetwork.h"
+
+//==============================================================================
+void DiffusionNetwork::prepare (int numLines, int numChannels, double maxDelaySamples, int maxSpanSize,
+                                bool doublePrecision, const KernelDispatch::Table& kernels)
+{
+    m_kernels = &kernels;
+    m_numLines = numLines >= maxLines ? maxLines : 8;
+    m_numGroups = juce::jlimit (1, m_numLines, numChannels);
+    m_maxSpan = juce::jmax (1, maxSpanSize);
+
+    // Long enough to hold a distinct prime for every line, however short the delay
+    m_maxLength = juce::jmax (64, static_cast<int> (std::ceil (maxDelaySamples)));
+
+    for (int group = 0; group < m_numGroups; ++group)
+    {
+        auto numGroupLines = (m_numLines - group + m_numGroups - 1) / m_numGroups;
+        m_groupGains[group] = 1.0f / std::sqrt (static_cast<float> (numGroupLines));
+    }
+
+    // Lines step down through the octave below the delay, taking turns between the groups
+    for (int line = 0; line < m_numLines; ++line)
+    {
+        m_spreads[line] = std::exp2 (-static_cast<float> (line) / static_cast<float> (m_numLines));
+        m_targetLengths[line] = 0;
+    }
+
+    m_isComposite.assign (static_cast<size_t> (m_maxLength) + 1, false);
+    m_isComposite[0] = m_isComposite[1] = true;
+
+    for (size_t factor = 2; factor * factor <= static_cast<size_t> (m_maxLength); ++factor)
+        if (! m_isComposite[factor])
+            for (auto multiple = factor * factor; multiple <= static_cast<size_t> (m_maxLength); multiple += factor)
+                m_isComposite[multiple] = true;
+
+    // Only the precision in use holds any lines
+    auto capacity = m_maxLength + m_maxSpan;
+    auto numScratch = m_numLines + 2 * m_numGroups + 1;
+
+    m_lines.setSize (doublePrecision ? 0 : m_numLines, doublePrecision ? 0 : capacity);
+    m_scratch.setSize (doublePrecision ? 0 : numScratch, doublePrecision ? 0 : m_maxSpan);
+    m_doubleLines.setSize (doublePrecision ? m_numLines : 0, doublePrecision ? capacity : 0);
+    m_doubleScratch.setSize (doublePrecision ? numScratch : 0, doublePrecision ? m_maxSpan : 0);
+
+    clear();
+
+    // Until the first setDelays(), the shortest distinct primes
+    m_shortest = 2;
+
+    for (int line = 0, length = 1; line < m_numLines; ++line)
+        m_lengths[line] = length = findPrime (length + 1, 1);
+}
+
+void DiffusionNetwork::clear() noexcept
+{
+    m_lines.clear();
+    m_doubleLines.clear();
+    m_writePosition = 0;
+}
+
+void DiffusionNetwork::setDelays (const float* const* channelDelaySamples, int numChannels) noexcept
+{
+    int targets[maxLines];
+    auto hasChanged = false;
+
+    for (int line = 0; line < m_numLines; ++line)
+    {
+        auto channel = juce::jmin (line % m_numGroups, numChannels - 1);
+        targets[line] = juce::jlimit (2, m_maxLength, static_cast<int> (channelDelaySamples[channel][0] * m_spreads[line]));
+        hasChanged = hasChanged || targets[line] != m_targetLengths[line];
+    }
+
+    if (! hasChanged)
+        return;
+
+    m_shortest = m_maxLength;
+
+    for (int line = 0; line < m_numLines; ++line)
+    {
+        // Two lines on one prime would share a period, so a taken prime moves the line on
+        auto isTaken = [this, line] (int length)
+        {
+            return std::find (m_lengths, m_lengths + line, length) != m_lengths + line;
+        };
+
+        auto length = findPrime (targets[line], 1);
+
+        while (length > 0 && isTaken (length))
+            length = findPrime (length + 1, 1);
+
+        // At the top of the range the line takes the next free prime below instead
+        if (length == 0)
+            for (length = findPrime (m_maxLength, -1); length > 0 && isTaken (length);)
+                length = findPrime (length - 1, -1);
+
+        m_targetLengths[line] = targets[line];
+        m_lengths[line] = length;
+        m_shortest = juce::jmin (m_shortest, length);
+    }
+}
+
+int DiffusionNetwork::findPrime (int start, int step) const noexcept
+{
+    for (auto candidate = start; candidate >= 2 && candidate <= m_maxLength; candidate += step)
+        if (! m_isComposite[static_cast<size_t> (candidate)])
+            return candidate;
+
+    return 0;
+}
+
+//==============================================================================
+template <typename SampleType>
+void DiffusionNetwork::process (SampleType* const* io, int numChannels, const float* wetGain, const float* feedback, int numSamples) noexcept
+{
+    auto& lines = getLines<SampleType>();
+    auto& scratch = getScratch<SampleType>();
+    auto& kernels = m_kernels->get<SampleType>();
+    const auto capacity = lines.getNumSamples();
+    const auto numLines = m_numLines, numGroups = m_numGroups;
+    const auto scale = static_cast<SampleType> (1.0 / std::sqrt (static_cast<double> (numLines)));
+
+    jassert (capacity > 0 && numChannels >= numGroups);
+
+    SampleType* outputs[maxLines];
+    SampleType* wet[maxLines];
+    const SampleType* inputs[maxLines];
+    int readPositions[maxLines];
+
+    for (int line = 0; line < numLines; ++line)
+        outputs[line] = scratch.getWritePointer (line);
+
+    for (int group = 0; group < numGroups; ++group)
+        wet[group] = scratch.getWritePointer (numLines + group);
+
+    auto* amounts = scratch.getWritePointer (numLines + 2 * numGroups);
+
+    for (int done = 0; done < numSamples;)
+    {
+        // Nothing a span reads may be written by the same span, and neither end may wrap
+        auto span = juce::jmin (numSamples - done, m_maxSpan, m_shortest, capacity - m_writePosition);
+
+        for (int line = 0; line < numLines; ++line)
+        {
+            readPositions[line] = (m_writePosition - m_lengths[line] + capacity) % capacity;
+            span = juce::jmin (span, capacity - readPositions[line]);
+        }
+
+        for (int line = 0; line < numLines; ++line)
+            juce::FloatVectorOperations::copy (outputs[line], lines.getReadPointer (line, readPositions[line]), span);
+
+        // A group hears its own lines, as they come out
+        for (int group = 0; group < numGroups; ++group)
+            juce::FloatVectorOperations::clear (wet[group], span);
+
+        for (int line = 0; line < numLines; ++line)
+            juce::FloatVectorOperations::add (wet[line % numGroups], outputs[line], span);
+
+        for (int group = 0; group < numGroups; ++group)
+            juce::FloatVectorOperations::multiply (wet[group], static_cast<SampleType> (m_groupGains[group]), span);
+
+        // More channels than lines share groups; their inputs are summed
+        for (int group = 0; group < numGroups; ++group)
+        {
+            inputs[group] = io[group] + done;
+
+            if (group + numGroups < numChannels)
+            {
+                auto* sum = scratch.getWritePointer (numLines + numGroups + group);
+                juce::FloatVectorOperations::copy (sum, io[group] + done, span);
+
+                for (int channel = group + numGroups; channel < numChannels; channel += numGroups)
+                    juce::FloatVectorOperations::add (sum, io[channel] + done, span);
+
+                inputs[group] = sum;
+            }
+        }
+
+        kernels.hadamard (outputs, numLines, span);
+
+        for (int i = 0; i < span; ++i)
+            amounts[i] = static_cast<SampleType> (feedback[done + i]) * scale;
+
+        for (int line = 0; line < numLines; ++line)
+        {
+            auto* destination = lines.getWritePointer (line, m_writePosition);
+            juce::FloatVectorOperations::copy (destination, inputs[line % numGroups], span);
+            juce::FloatVectorOperations::addWithMultiply (destination, amounts, outputs[line], span);
+        }
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            kernels.mixWet (io[channel] + done, wet[channel % numGroups], wetGain + done, span);
+
+        m_writePosition = (m_writePosition + span) % capacity;
+        done += span;
+    }
+}
+
+template void DiffusionNetwork::process (float* const*, int, const float*, const float*, int) noexcept;
+template void DiffusionNetwork::process (double* const*, int, const float*, const float*, int) noexcept;
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    DiffusionNetwork.h
+    Created: 23 Oct 2026 9:58:40am
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "KernelDispatch.h"
+
+//==============================================================================
+/**
+    The diffuse mode: a feedback delay network of 8 or 16 lines in place of
+    the single delay line.
+
+    The channels are split into groups, one per channel up to the number of
+    lines. Each group feeds its input into every line k with k % numGroups ==
+    its index, and hears the sum of those same lines. On the way back in, the
+    line outputs are mixed through a Hadamard matrix scaled by FEEDBACK /
+    sqrt (numLines). That matrix is orthogonal, so FEEDBACK alone sets how
+    fast the network decays, just as it does for the single line.
+
+    The line lengths are distinct primes, so no two lines share a common
+    period and the echoes smear into a dense tail. They are spread over the
+    octave below each group's delay, which is DELAYTIME plus the speaker's
+    share of STEREO. They are whole samples and follow the delay once per
+    sub-block.
+
+    A span never runs past the shortest line, so every sample read was
+    written by an earlier span. The work then goes line by line and runs
+    along the span: copies, butterflies and multiply-adds over contiguous
+    arrays.
+*/
+class DiffusionNetwork
+{
+public:
+    static constexpr int maxLines = 16;
+
+    DiffusionNetwork() = default;
+
+    /** Allocates numLines (8 or 16) lines in the processing precision, each long enough
+        for a delay of maxDelaySamples, and scratch for spans of up to maxSpanSize.
+        Not real-time safe.
+    */
+    void prepare (int numLines, int numChannels, double maxDelaySamples, int maxSpanSize,
+                  bool doublePrecision, const KernelDispatch::Table& kernels);
+
+    void clear() noexcept;
+
+    int getNumLines() const noexcept        { return m_numLines; }
+
+    /** Sets the line lengths from the delay of each channel in samples. The primes
+        are only searched for again when a whole-sample length has changed.
+    */
+    void setDelays (const float* const* channelDelaySamples, int numChannels) noexcept;
+
+    /** Runs the network over numSamples of every channel, adding its output to the
+        input in place with the wet gain ramp.
+    */
+    template <typename SampleType>
+    void process (SampleType* const* io, int numChannels, const float* wetGain, const float* feedback, int numSamples) noexcept;
+
+private:
+    // The first prime from start on in the direction of step (1 or -1), or 0 if the lines can't reach one
+    int findPrime (int start, int step) const noexcept;
+
+    template <typename SampleType>
+    juce::AudioBuffer<SampleType>& getLines() noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, float>)
+            return m_lines;
+        else
+            return m_doubleLines;
+    }
+
+    template <typename SampleType>
+    juce::AudioBuffer<SampleType>& getScratch() noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, float>)
+            return m_scratch;
+        else
+            return m_doubleScratch;
+    }
+
+    int m_numLines = 8;
+    int m_numGroups = 1;
+    int m_maxSpan = 1;
+    int m_maxLength = 2;
+    int m_writePosition = 0;
+
+    int m_lengths[maxLines] = {};
+    int m_targetLengths[maxLines] = {};     // before rounding to primes, to spot a change
+    float m_spreads[maxLines] = {};         // each line's fraction of its group's delay
+    int m_shortest = 2;
+    float m_groupGains[maxLines] = {};      // 1 / sqrt (lines in the group)
+
+    std::vector<bool> m_isComposite;        // sieve up to the longest line
+
+    // Rows: the lines' outputs, then a wet and an input row per group, then the feedback ramp
+    juce::AudioBuffer<float> m_lines, m_scratch;
+    juce::AudioBuffer<double> m_doubleLines, m_doubleScratch;
+
+    const KernelDispatch::Table* m_kernels = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (DiffusionNetwork)
+};
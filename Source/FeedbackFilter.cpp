@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+    FeedbackFilter.cpp
+    Created: 18 Oct 2026 5:21:46pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#include "FeedbackFilter.h"
+
+//==============================================================================
+template <typename SampleType>
+typename FeedbackFilter<SampleType>::Design FeedbackFilter<SampleType>::design (double sampleRate, float lowCutHz, float highCutHz)
+{
+    using ArrayCoefficients = juce::dsp::IIR::ArrayCoefficients<SampleType>;
+    auto nyquistLimit = static_cast<float> (sampleRate * 0.45);
+
+    Design result;
+    result.lowCutActive = lowCutHz > minimumLowCut;
+    result.highCutActive = highCutHz < juce::jmin (maximumHighCut, nyquistLimit);
+
+    if (result.lowCutActive)
+        result.lowCut = ArrayCoefficients::makeHighPass (sampleRate, static_cast<SampleType> (juce::jmin (lowCutHz, nyquistLimit)));
+
+    if (result.highCutActive)
+        result.highCut = ArrayCoefficients::makeLowPass (sampleRate, static_cast<SampleType> (juce::jmin (highCutHz, nyquistLimit)));
+
+    return result;
+}
+
+template <typename SampleType>
+void FeedbackFilter<SampleType>::prepare (int maxSpanSize)
+{
+    m_output.setSize (maxChannels, juce::jmax (1, maxSpanSize));
+    m_output.clear();
+
+    // Give both stages biquad coefficients now, so later updates reuse them in place
+    using Coefficients = juce::dsp::IIR::Coefficients<SampleType>;
+    typename Coefficients::Ptr lowCut = new Coefficients (1, 0, 0, 1, 0, 0);
+    typename Coefficients::Ptr highCut = new Coefficients (1, 0, 0, 1, 0, 0);
+
+    for (int group = 0; group < maxGroups; ++group)
+    {
+        m_lowCut[group].coefficients = lowCut;
+        m_highCut[group].coefficients = highCut;
+        m_lowCut[group].reset();
+        m_highCut[group].reset();
+    }
+
+    m_design = {};
+}
+
+template <typename SampleType>
+void FeedbackFilter<SampleType>::setDesign (const Design& design) noexcept
+{
+    // A stage that comes back on starts from silence rather than from stale state
+    if (design.lowCutActive != m_design.lowCutActive || design.lowCut != m_design.lowCut)
+    {
+        if (design.lowCutActive)
+        {
+            *m_lowCut[0].coefficients = design.lowCut;
+
+            if (! m_design.lowCutActive)
+                for (auto& filter : m_lowCut)
+                    filter.reset();
+        }
+
+        m_design.lowCutActive = design.lowCutActive;
+        m_design.lowCut = design.lowCut;
+    }
+
+    if (design.highCutActive != m_design.highCutActive || design.highCut != m_design.highCut)
+    {
+        if (design.highCutActive)
+        {
+            *m_highCut[0].coefficients = design.highCut;
+
+            if (! m_design.highCutActive)
+                for (auto& filter : m_highCut)
+                    filter.reset();
+        }
+
+        m_design.highCutActive = design.highCutActive;
+        m_design.highCut = design.highCut;
+    }
+}
+
+template <typename SampleType>
+void FeedbackFilter<SampleType>::process (const SampleType* const* inputs, int numChannels, int numSamples) noexcept
+{
+    jassert (numChannels <= maxChannels && numSamples <= m_output.getNumSamples());
+
+    if (m_design.lowCutActive && m_design.highCutActive)
+        processStages<true, true> (inputs, numChannels, numSamples);
+    else if (m_design.lowCutActive)
+        processStages<true, false> (inputs, numChannels, numSamples);
+    else if (m_design.highCutActive)
+        processStages<false, true> (inputs, numChannels, numSamples);
+}
+
+template <typename SampleType>
+template <bool lowCut, bool highCut>
+void FeedbackFilter<SampleType>::processStages (const SampleType* const* inputs, int numChannels, int numSamples) noexcept
+{
+    for (int group = 0; group * numLanes < numChannels; ++group)
+        processGroup<lowCut, highCut> (group, inputs + group * numLanes,
+                                       juce::jmin (numLanes, numChannels - group * numLanes), numSamples);
+}
+
+template <typename SampleType>
+template <bool lowCut, bool highCut>
+void FeedbackFilter<SampleType>::processGroup (int group, const SampleType* const* inputs, int numChannels, int numSamples) noexcept
+{
+    // Channels are packed into the lanes of one register per sample
+    alignas (Register::SIMDRegisterSize) SampleType frame[Register::SIMDNumElements] = {};
+    SampleType* outputs[numLanes] = {};
+    auto& lowCutFilter = m_lowCut[group];
+    auto& highCutFilter = m_highCut[group];
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        outputs[channel] = m_output.getWritePointer (group * numLanes + channel);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            frame[channel] = inputs[channel][i];
+
+        auto sample = Register::fromRawArray (frame);
+
+        if constexpr (lowCut)
+            sample = lowCutFilter.processSample (sample);
+
+        if constexpr (highCut)
+            sample = highCutFilter.processSample (sample);
+
+        sample.copyToRawArray (frame);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            outputs[channel][i] = frame[channel];
+    }
+
+    lowCutFilter.snapToZero();
+    highCutFilter.snapToZero();
+}
+
+//==============================================================================
+template class FeedbackFilter<float>;
+template class FeedbackFilter<double>;
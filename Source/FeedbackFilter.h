@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    FeedbackFilter.h
+    Created: 18 Oct 2026 5:21:46pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SpeakerLayout.h"
+
+//==============================================================================
+/**
+    Tone stage for the repeats: a high-pass (LOWCUT) into a low-pass (HIGHCUT).
+
+    Both biquads run on juce::dsp::SIMDRegister samples with one channel per
+    lane, so a stereo pair is filtered by a single instruction stream instead
+    of two scalar loops. Wider layouts are split into groups of one register
+    each (four channels with SSE or NEON), all sharing one set of
+    coefficients, so a 7.1.4 bed is three register streams rather than twelve
+    scalar ones. Designing the biquads for a pair of cutoffs is kept apart
+    from running them: design() does the trigonometry, off the audio thread
+    (see CoefficientWorker), and setDesign() only copies the result in place,
+    without allocating. A stage at the edge of its range is skipped.
+
+    SampleType is the processing precision. A double filter holds half as
+    many channels per register, so it runs twice as many groups.
+*/
+template <typename SampleType>
+class FeedbackFilter
+{
+public:
+    using Register = juce::dsp::SIMDRegister<SampleType>;
+
+    static constexpr int numLanes = static_cast<int> (Register::SIMDNumElements);
+    static constexpr int maxChannels = SpeakerLayout::maxChannels;
+    static constexpr int maxGroups = (maxChannels + numLanes - 1) / numLanes;
+    static constexpr float minimumLowCut = 20.0f;
+    static constexpr float maximumHighCut = 20000.0f;
+
+    /** Both stages designed for one pair of cutoffs. */
+    struct Design
+    {
+        bool lowCutActive = false, highCutActive = false;
+        std::array<SampleType, 6> lowCut {}, highCut {};
+    };
+
+    FeedbackFilter() = default;
+
+    /** Designs both stages for the given cutoffs. Too slow for the audio thread. */
+    static Design design (double sampleRate, float lowCutHz, float highCutHz);
+
+    /** Allocates the filter state and output for spans of up to maxSpanSize. Not real-time safe. */
+    void prepare (int maxSpanSize);
+
+    /** Switches to a design; only a changed stage is touched. */
+    void setDesign (const Design& design) noexcept;
+
+    /** False when both stages are open, in which case process() shouldn't be called. */
+    bool isActive() const noexcept      { return m_design.lowCutActive || m_design.highCutActive; }
+
+    /** Filters numSamples of each input channel into the internal output. */
+    void process (const SampleType* const* inputs, int numChannels, int numSamples) noexcept;
+
+    const SampleType* getOutput (int channel) const noexcept    { return m_output.getReadPointer (channel); }
+
+private:
+    template <bool lowCut, bool highCut>
+    void processStages (const SampleType* const* inputs, int numChannels, int numSamples) noexcept;
+
+    template <bool lowCut, bool highCut>
+    void processGroup (int group, const SampleType* const* inputs, int numChannels, int numSamples) noexcept;
+
+    // One filter pair per group of lanes; the coefficients objects are shared by all groups
+    juce::dsp::IIR::Filter<Register> m_lowCut[maxGroups], m_highCut[maxGroups];
+    Design m_design;
+
+    juce::AudioBuffer<SampleType> m_output;
+
+    JUCE_DECLARE_NON_COPYABLE (FeedbackFilter)
+};
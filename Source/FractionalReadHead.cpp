@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+    FractionalReadHead.cpp
+    Created: 18 Oct 2026 2:37:10pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#include "FractionalReadHead.h"
+
+//==============================================================================
+template <typename SampleType>
+void FractionalReadHead<SampleType>::prepare (int maxSpanSize, const KernelDispatch::Table& kernels)
+{
+    m_kernels = &kernels.get<SampleType>();
+    m_scratch.setSize (numScratch, juce::jmax (1, maxSpanSize));
+    m_scratch.clear();
+    m_output = m_scratch.getReadPointer (output);
+}
+
+template <typename SampleType>
+template <Interpolation interpolation, typename StorageType>
+int FractionalReadHead<SampleType>::read (const DelayRingBuffer<StorageType>& ring, int channel, int writePosition,
+                                          const float* delaySamples, int numSamples) noexcept
+{
+    // A ring in the processing precision is read in place; a half-precision one is decoded
+    constexpr auto isDirect = std::is_same_v<StorageType, SampleType>;
+    constexpr auto isFloat = std::is_same_v<SampleType, float>;
+
+    auto guardSize = ring.getGuardSize();
+    auto maximumDelay = static_cast<SampleType> (ring.getCapacity() - guardSize) - static_cast<SampleType> (minimumDelay);
+    jassert (guardSize > static_cast<int> (minimumDelay) + 2);
+
+    numSamples = juce::jmin (numSamples, guardSize, m_scratch.getNumSamples());
+
+    auto* delays = m_scratch.getWritePointer (clippedDelays);
+
+    if constexpr (isFloat)
+        juce::FloatVectorOperations::clip (delays, delaySamples, minimumDelay, maximumDelay, numSamples);
+    else
+        for (int i = 0; i < numSamples; ++i)
+            delays[i] = juce::jlimit (static_cast<SampleType> (minimumDelay), maximumDelay, static_cast<SampleType> (delaySamples[i]));
+
+    // Shrink the span until the newest tap of its last sample is older than the span
+    // itself, and the taps of every sample fit in one straight window of the guard
+    juce::Range<SampleType> range;
+    int windowLength;
+
+    for (;;)
+    {
+        range = juce::FloatVectorOperations::findMinAndMax (delays, numSamples);
+
+        auto longestSpan = static_cast<int> (range.getStart()) - 3;
+        windowLength = numSamples + static_cast<int> (std::ceil (range.getLength())) + 5;
+
+        if (numSamples <= longestSpan && windowLength <= guardSize)
+            break;
+
+        numSamples = juce::jmax (1, juce::jmin (numSamples / 2, longestSpan));
+    }
+
+    // A constant, whole-sample delay is just a straight read, or a de-interleaving copy
+    if (range.getLength() == 0 && range.getStart() == std::floor (range.getStart()))
+    {
+        auto* source = ring.getReadPointer (channel, ring.wrap (writePosition - static_cast<int> (range.getStart())));
+        auto stride = ring.getStride();
+        auto* destination = m_scratch.getWritePointer (output);
+
+        if constexpr (isDirect)
+        {
+            if (stride == 1)
+            {
+                m_output = source;
+                return numSamples;
+            }
+
+            for (int i = 0; i < numSamples; ++i)
+                destination[i] = source[i * stride];
+        }
+        else
+        {
+            m_kernels->decodeHalf (source, stride, destination, numSamples);
+        }
+
+        m_output = destination;
+        return numSamples;
+    }
+
+    // Positions are relative to a window starting one sample before the oldest tap.
+    // Subtracting the large delays from the window offset first keeps the fraction exact.
+    auto windowOffset = static_cast<int> (std::ceil (range.getEnd())) + 1;
+    auto* storedWindow = ring.getReadPointer (channel, ring.wrap (writePosition - windowOffset));
+    const SampleType* window;
+    int windowStride;
+
+    if constexpr (isDirect)
+    {
+        window = storedWindow;
+        windowStride = ring.getStride();
+    }
+    else
+    {
+        auto* decoded = m_scratch.getWritePointer (decodedWindow);
+        m_kernels->decodeHalf (storedWindow, ring.getStride(), decoded, windowLength);
+        window = decoded;
+        windowStride = 1;
+    }
+
+    auto* readPositions = m_scratch.getWritePointer (positions);
+
+    for (int i = 0; i < numSamples; ++i)
+        readPositions[i] = (static_cast<SampleType> (windowOffset) - delays[i]) + static_cast<SampleType> (i);
+
+    auto* tapBefore = m_scratch.getWritePointer (before);
+    auto* tapAt = m_scratch.getWritePointer (at);
+    auto* tapAfter = m_scratch.getWritePointer (after);
+    auto* tapAfterNext = m_scratch.getWritePointer (afterNext);
+    auto* tapFraction = m_scratch.getWritePointer (fraction);
+    auto* destination = m_scratch.getWritePointer (output);
+
+    m_kernels->gatherTaps (window, windowStride, readPositions, tapBefore, tapAt, tapAfter, tapAfterNext, tapFraction, numSamples);
+    m_kernels->interpolate[static_cast<int> (interpolation)] (tapBefore, tapAt, tapAfter, tapAfterNext, tapFraction, destination, numSamples);
+
+    m_output = destination;
+    return numSamples;
+}
+
+//==============================================================================
+template class FractionalReadHead<float>;
+template class FractionalReadHead<double>;
+
+template int FractionalReadHead<float>::read<Interpolation::linear> (const DelayRingBuffer<float>&, int, int, const float*, int) noexcept;
+template int FractionalReadHead<float>::read<Interpolation::lagrange3> (const DelayRingBuffer<float>&, int, int, const float*, int) noexcept;
+template int FractionalReadHead<float>::read<Interpolation::hermite> (const DelayRingBuffer<float>&, int, int, const float*, int) noexcept;
+template int FractionalReadHead<float>::read<Interpolation::linear> (const DelayRingBuffer<HalfFloat::Bits>&, int, int, const float*, int) noexcept;
+template int FractionalReadHead<float>::read<Interpolation::lagrange3> (const DelayRingBuffer<HalfFloat::Bits>&, int, int, const float*, int) noexcept;
+template int FractionalReadHead<float>::read<Interpolation::hermite> (const DelayRingBuffer<HalfFloat::Bits>&, int, int, const float*, int) noexcept;
+template int FractionalReadHead<double>::read<Interpolation::linear> (const DelayRingBuffer<double>&, int, int, const float*, int) noexcept;
+template int FractionalReadHead<double>::read<Interpolation::lagrange3> (const DelayRingBuffer<double>&, int, int, const float*, int) noexcept;
+template int FractionalReadHead<double>::read<Interpolation::hermite> (const DelayRingBuffer<double>&, int, int, const float*, int) noexcept;
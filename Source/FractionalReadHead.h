@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    FractionalReadHead.h
+    Created: 18 Oct 2026 2:37:10pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DelayKernels.h"
+#include "DelayRingBuffer.h"
+#include "HalfFloat.h"
+#include "KernelDispatch.h"
+
+//==============================================================================
+/**
+    Reads a DelayRingBuffer at a per-sample fractional delay.
+
+    Each call produces the delayed signal for as much of a span as can be
+    read out of one straight window of the ring buffer, and whose taps were
+    all written before the span started. The taps are gathered into
+    structure-of-arrays scratch and the interpolator then runs across the
+    whole span at once.
+
+    A span whose delay is constant and a whole number of samples is served
+    straight from the ring buffer, so a fixed delay doesn't pay for the
+    interpolation.
+
+    A half-precision ring is decoded one window at a time into float scratch,
+    so only the samples a span actually touches are converted.
+
+    The interpolator is a template argument, so the caller picks it once for
+    the whole processing path rather than the head switching on it per span.
+
+    SampleType is the processing precision, float or double. A double head
+    reads a double ring and interpolates in double, with the double kernels
+    of the same dispatched variant.
+*/
+template <typename SampleType>
+class FractionalReadHead
+{
+public:
+    FractionalReadHead() = default;
+
+    /** Shortest delay the head will read, so that the interpolator taps can't reach the write head. */
+    static constexpr float minimumDelay = 4.0f;
+
+    /** Allocates scratch for spans of up to maxSpanSize samples, to be read
+        with the given kernels. Not real-time safe.
+    */
+    void prepare (int maxSpanSize, const KernelDispatch::Table& kernels);
+
+    /** Reads the delayed signal for the span starting at writePosition, with
+        delaySamples[i] the delay of its i-th sample. Returns how many of the
+        numSamples were produced; they are available from getOutput().
+    */
+    template <Interpolation interpolation, typename StorageType>
+    int read (const DelayRingBuffer<StorageType>& ring, int channel, int writePosition,
+              const float* delaySamples, int numSamples) noexcept;
+
+    const SampleType* getOutput() const noexcept    { return m_output; }
+
+private:
+    enum Scratch { clippedDelays, positions, before, at, after, afterNext, fraction, output, decodedWindow, numScratch };
+
+    juce::AudioBuffer<SampleType> m_scratch;
+    const SampleType* m_output = nullptr;
+    const KernelDispatch::Kernels<SampleType>* m_kernels = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (FractionalReadHead)
+};
@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    HalfFloat.h
+    Created: 19 Oct 2026 6:22:40pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/** Set to 1 to store the delay line in half precision unless the processor is told otherwise. */
+#ifndef FRACTURE_HALF_PRECISION_DELAY
+ #define FRACTURE_HALF_PRECISION_DELAY 0
+#endif
+
+//==============================================================================
+/**
+    IEEE 754 binary16 storage for the delay line.
+
+    Half precision keeps 11 bits of mantissa at every level, so a decaying
+    tail loses no relative accuracy on its way down to the idle threshold,
+    and the exponent leaves headroom up to 65504. Values beyond that
+    saturate rather than becoming infinity, which would never leave a
+    feedback loop again.
+
+    Spans are converted by the dispatched encodeHalf and decodeHalf kernels
+    (see KernelDispatch.h), so the AVX2 and AVX-512 variants use F16C while
+    the plugin itself targets the baseline, and the other variants use a
+    branch-light scalar routine. The two give the same bits for every input,
+    NaNs included. Processing stays in float.
+*/
+namespace HalfFloat
+{
+    using Bits = juce::uint16;
+
+    static constexpr float maximum = 65504.0f;
+
+    static_assert (std::is_same_v<Bits, unsigned short>, "the kernels convert to and from unsigned short");
+}
@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    IdleDetector.h
+    Created: 19 Oct 2026 9:48:03am
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Decides when the delay line holds nothing audible any more.
+
+    After each processed block it is told the peak of what went into the ring
+    buffer. Once the last loud write is further back than anything a read
+    head can reach, the line is dead and the processor can go to sleep until
+    the input comes back above the threshold.
+*/
+class IdleDetector
+{
+public:
+    IdleDetector() = default;
+
+    /** Level below which a sample counts as silence (-90 dB). */
+    static constexpr float silenceThreshold = 3.1623e-5f;
+
+    void reset() noexcept
+    {
+        m_quietSamples = 0;
+        m_sleeping = false;
+    }
+
+    bool isSleeping() const noexcept        { return m_sleeping; }
+
+    static bool isSilent (float peak) noexcept  { return peak < silenceThreshold; }
+
+    /** Call with the peak written into the ring this block and the longest
+        delay a read head may use. Returns true when the line just went quiet.
+    */
+    bool update (float writtenPeak, int numSamples, int longestDelaySamples) noexcept
+    {
+        m_quietSamples = isSilent (writtenPeak) ? m_quietSamples + numSamples : 0;
+
+        if (m_quietSamples > longestDelaySamples)
+        {
+            m_sleeping = true;
+            return true;
+        }
+
+        return false;
+    }
+
+    void wake() noexcept
+    {
+        m_quietSamples = 0;
+        m_sleeping = false;
+    }
+
+private:
+    int m_quietSamples = 0;
+    bool m_sleeping = false;
+};
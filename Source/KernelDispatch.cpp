@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    KernelDispatch.cpp
+    Created: 20 Oct 2026 10:14:05am
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "KernelDispatch.h"
+
+//==============================================================================
+static bool canRun (KernelDispatch::Isa isa) noexcept
+{
+    using Isa = KernelDispatch::Isa;
+
+    switch (isa)
+    {
+        // The compilers may contract the AVX2 build's multiply-adds into FMA
+        case Isa::avx2:     return juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3();
+
+        case Isa::avx512:   return juce::SystemStats::hasAVX512F() && juce::SystemStats::hasAVX512CD()
+                                && juce::SystemStats::hasAVX512BW() && juce::SystemStats::hasAVX512DQ()
+                                && juce::SystemStats::hasAVX512VL();
+
+        case Isa::automatic:
+        case Isa::scalar:
+        case Isa::baseline:
+        default:            return true;
+    }
+}
+
+const KernelDispatch::Table* KernelDispatch::getTable (Isa isa) noexcept
+{
+    const Table* table = nullptr;
+
+    switch (isa)
+    {
+        case Isa::automatic:    return getTable (getBest());
+        case Isa::scalar:       table = getScalarTable(); break;
+        case Isa::baseline:     table = getBaselineTable(); break;
+        case Isa::avx2:         table = getAvx2Table(); break;
+        case Isa::avx512:       table = getAvx512Table(); break;
+        default:                break;
+    }
+
+    return canRun (isa) ? table : nullptr;
+}
+
+KernelDispatch::Isa KernelDispatch::getBest() noexcept
+{
+    static const Isa best = []
+    {
+        for (auto isa : { Isa::avx512, Isa::avx2, Isa::baseline })
+            if (getTable (isa) != nullptr)
+                return isa;
+
+        return Isa::scalar;
+    }();
+
+    return best;
+}
+
+const char* KernelDispatch::getName (Isa isa) noexcept
+{
+    switch (isa)
+    {
+        case Isa::automatic:    return getName (getBest());
+        case Isa::scalar:       return "scalar";
+       #if JUCE_INTEL
+        case Isa::baseline:     return "SSE2";
+       #elif JUCE_ARM
+        case Isa::baseline:     return "NEON";
+       #else
+        case Isa::baseline:     return "baseline";
+       #endif
+        case Isa::avx2:         return "AVX2";
+        case Isa::avx512:       return "AVX-512";
+        default:                return "";
+    }
+}
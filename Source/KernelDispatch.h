@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    KernelDispatch.h
+    Created: 20 Oct 2026 10:14:05am
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "DelayKernels.h"
+
+#include <type_traits>
+
+//==============================================================================
+/**
+    Runtime choice between builds of the DelayKernels for several instruction
+    sets.
+
+    The plugin binary targets a baseline ISA (SSE2 on x64, NEON on arm64), so
+    the kernels are compiled again in their own translation units with the
+    AVX2 and AVX-512 compiler flag schemes, and once more with vectorisation
+    disabled as a scalar reference. The best variant this build has and this
+    CPU supports is picked the first time a processor is created, and the
+    processor hands its Table to every stage that runs a kernel.
+
+    Variant translation units include this header and DelayKernels.h only, so
+    no inline code is shared between variants built with different flags.
+    Every variant carries kernels for both float and double processing.
+*/
+namespace KernelDispatch
+{
+    /** Kernel variants, from the slowest. The names match each variant's FRACTURE_KERNEL_ISA. */
+    enum class Isa
+    {
+        automatic,      // the best available
+        scalar,
+        baseline,
+        avx2,
+        avx512
+    };
+
+    /** Entry points of one variant for one processing precision. The parameter ramps are always float. */
+    template <typename SampleType>
+    struct Kernels
+    {
+        void (*readMixWrite) (SampleType*, SampleType*, const SampleType*, const float*, const float*, int) noexcept;
+        void (*readMixWriteStereo) (SampleType*, SampleType*, SampleType*, const SampleType*, const SampleType*,
+                                    const float*, const float*, int) noexcept;
+        void (*mixWet) (SampleType*, const SampleType*, const float*, int) noexcept;
+        void (*gatherTaps) (const SampleType*, int, const SampleType*, SampleType*, SampleType*, SampleType*,
+                            SampleType*, SampleType*, int) noexcept;
+        void (*sumTaps) (const SampleType*, const SampleType*, int, SampleType*, int) noexcept;
+        void (*interleaveLanes) (const SampleType* const*, int, SampleType*, int) noexcept;
+        void (*deinterleaveLanes) (const SampleType*, int, SampleType* const*, int) noexcept;
+        void (*gatherLanes) (const SampleType*, const SampleType*, SampleType*, SampleType*, SampleType*,
+                             SampleType*, SampleType*, int) noexcept;
+        void (*readMixWriteLanes) (SampleType*, SampleType*, const SampleType*, const float*, const float*, int) noexcept;
+        void (*interpolate[3]) (const SampleType*, const SampleType*, const SampleType*, const SampleType*,
+                                const SampleType*, SampleType*, int) noexcept;     // by Interpolation
+        void (*hadamard) (SampleType* const*, int, int) noexcept;
+        void (*complexMultiplyAdd) (SampleType*, const SampleType*, const SampleType*, int) noexcept;
+        void (*encodeHalf) (const SampleType*, unsigned short*, int, int) noexcept;
+        void (*decodeHalf) (const unsigned short*, int, SampleType*, int) noexcept;
+    };
+
+    /** One variant, in both processing precisions. */
+    struct Table
+    {
+        Isa isa;
+        Kernels<float> floatKernels;
+        Kernels<double> doubleKernels;
+
+        template <typename SampleType>
+        const Kernels<SampleType>& get() const noexcept
+        {
+            if constexpr (std::is_same_v<SampleType, float>)
+                return floatKernels;
+            else
+                return doubleKernels;
+        }
+    };
+
+    /** The variant's table, or nullptr if it wasn't built or the CPU can't run it. */
+    const Table* getTable (Isa isa) noexcept;
+
+    /** The fastest variant available, worked out once per process. */
+    Isa getBest() noexcept;
+
+    const char* getName (Isa isa) noexcept;
+
+    //==============================================================================
+    // One per variant translation unit; nullptr when it was built without its flags
+    const Table* getScalarTable() noexcept;
+    const Table* getBaselineTable() noexcept;
+    const Table* getAvx2Table() noexcept;
+    const Table* getAvx512Table() noexcept;
+}
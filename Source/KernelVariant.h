@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    KernelVariant.h
+    Created: 20 Oct 2026 10:14:05am
+    Author:  97252
+
+    Included once by each Kernels*.cpp, after it has defined FRACTURE_KERNEL_ISA,
+    to build that variant's table.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "KernelDispatch.h"
+
+namespace
+{
+    template <typename SampleType>
+    constexpr KernelDispatch::Kernels<SampleType> makeVariantKernels() noexcept
+    {
+        return {
+            &DelayKernels::readMixWrite<SampleType>,
+            &DelayKernels::readMixWriteStereo<SampleType>,
+            &DelayKernels::mixWet<SampleType>,
+            &DelayKernels::gatherTaps<SampleType>,
+            &DelayKernels::sumTaps<SampleType>,
+            &DelayKernels::interleaveLanes<SampleType>,
+            &DelayKernels::deinterleaveLanes<SampleType>,
+            &DelayKernels::gatherLanes<SampleType>,
+            &DelayKernels::readMixWriteLanes<SampleType>,
+            {
+                &DelayKernels::interpolate<Interpolation::linear, SampleType>,
+                &DelayKernels::interpolate<Interpolation::lagrange3, SampleType>,
+                &DelayKernels::interpolate<Interpolation::hermite, SampleType>
+            },
+            &DelayKernels::hadamard<SampleType>,
+            &DelayKernels::complexMultiplyAdd<SampleType>,
+            &DelayKernels::encodeHalf<SampleType>,
+            &DelayKernels::decodeHalf<SampleType>
+        };
+    }
+
+    const KernelDispatch::Table variantTable
+    {
+        KernelDispatch::Isa::FRACTURE_KERNEL_ISA,
+        makeVariantKernels<float>(),
+        makeVariantKernels<double>()
+    };
+}
@@ -0,0 +1,23 @@
+/*
+  ==============================================================================
+
+    KernelsAVX2.cpp
+    Created: 20 Oct 2026 10:14:05am
+    Author:  97252
+
+    Built with the AVX2 compiler flag scheme (AVX2 and FMA). Without it the
+    variant is left out rather than built for the baseline a second time.
+
+  ==============================================================================
+*/
+
+#if defined (__AVX2__)
+ #define FRACTURE_KERNEL_ISA avx2
+ #include "KernelVariant.h"
+
+ const KernelDispatch::Table* KernelDispatch::getAvx2Table() noexcept     { return &variantTable; }
+#else
+ #include "KernelDispatch.h"
+
+ const KernelDispatch::Table* KernelDispatch::getAvx2Table() noexcept     { return nullptr; }
+#endif
@@ -0,0 +1,24 @@
+/*
+  ==============================================================================
+
+    KernelsAVX512.cpp
+    Created: 20 Oct 2026 10:14:05am
+    Author:  97252
+
+    Built with the AVX512 compiler flag scheme (AVX-512 F, CD, BW, DQ and VL).
+    Without it the variant is left out rather than built for the baseline a
+    second time.
+
+  ==============================================================================
+*/
+
+#if defined (__AVX512F__)
+ #define FRACTURE_KERNEL_ISA avx512
+ #include "KernelVariant.h"
+
+ const KernelDispatch::Table* KernelDispatch::getAvx512Table() noexcept   { return &variantTable; }
+#else
+ #include "KernelDispatch.h"
+
+ const KernelDispatch::Table* KernelDispatch::getAvx512Table() noexcept   { return nullptr; }
+#endif
@@ -0,0 +1,17 @@
+/*
+  ==============================================================================
+
+    KernelsBaseline.cpp
+    Created: 20 Oct 2026 10:14:05am
+    Author:  97252
+
+    The kernels built with the project's own flags, so for SSE2 on x64 and
+    NEON on arm64. Every CPU the plugin loads on can run them.
+
+  ==============================================================================
+*/
+
+#define FRACTURE_KERNEL_ISA baseline
+#include "KernelVariant.h"
+
+const KernelDispatch::Table* KernelDispatch::getBaselineTable() noexcept  { return &variantTable; }
@@ -0,0 +1,22 @@
+/*
+  ==============================================================================
+
+    KernelsScalar.cpp
+    Created: 20 Oct 2026 10:14:05am
+    Author:  97252
+
+    The kernels with vectorisation disabled: the reference the other variants
+    are benchmarked against, and the fallback if nothing else can run.
+
+  ==============================================================================
+*/
+
+#if defined (__GNUC__) && ! defined (__clang__)
+ #pragma GCC optimize ("no-tree-vectorize")
+#endif
+
+#define FRACTURE_KERNEL_ISA scalar
+#define FRACTURE_KERNEL_SCALAR 1
+#include "KernelVariant.h"
+
+const KernelDispatch::Table* KernelDispatch::getScalarTable() noexcept    { return &variantTable; }
@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    LanedReadHead.cpp
+    Created: 24 Oct 2026 11:02:51am
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#include "LanedReadHead.h"
+
+//==============================================================================
+template <typename SampleType>
+void LanedReadHead<SampleType>::prepare (int maxSpanSize, const KernelDispatch::Table& kernels)
+{
+    m_kernels = &kernels.get<SampleType>();
+    m_maxSpanSize = juce::jmax (1, maxSpanSize);
+
+    // Every row holds a span, or a window, of whole frames
+    m_scratch.setSize (numScratch, m_maxSpanSize * lanes);
+    m_scratch.clear();
+}
+
+template <typename SampleType>
+template <Interpolation interpolation, typename StorageType>
+int LanedReadHead<SampleType>::read (const DelayRingBuffer<StorageType>& ring, int firstChannel, int numChannels, int writePosition,
+                                     const float* const* delaySamples, int numSamples) noexcept
+{
+    constexpr auto isDirect = std::is_same_v<StorageType, SampleType>;
+    constexpr auto isFloat = std::is_same_v<SampleType, float>;
+
+    jassert (ring.getLayout() == DelayLayout::laned && juce::isPositiveAndNotGreaterThan (numChannels, lanes));
+
+    auto guardSize = ring.getGuardSize();
+    auto maximumDelay = static_cast<SampleType> (ring.getCapacity() - guardSize) - static_cast<SampleType> (minimumDelay);
+    jassert (guardSize > static_cast<int> (minimumDelay) + 2);
+
+    numSamples = juce::jmin (numSamples, guardSize, m_maxSpanSize);
+
+    // One row of clipped delays per channel, m_maxSpanSize apart
+    auto* delays = m_scratch.getWritePointer (clippedDelays);
+
+    for (int lane = 0; lane < numChannels; ++lane)
+    {
+        auto* row = delays + lane * m_maxSpanSize;
+
+        if constexpr (isFloat)
+            juce::FloatVectorOperations::clip (row, delaySamples[lane], minimumDelay, maximumDelay, numSamples);
+        else
+            for (int i = 0; i < numSamples; ++i)
+                row[i] = juce::jlimit (static_cast<SampleType> (minimumDelay), maximumDelay, static_cast<SampleType> (delaySamples[lane][i]));
+    }
+
+    // Shrink the span until the newest tap of its last sample is older than the span
+    // itself, and the taps of every channel fit in one straight window of the guard
+    juce::Range<SampleType> range;
+    int windowLength;
+
+    for (;;)
+    {
+        range = juce::FloatVectorOperations::findMinAndMax (delays, numSamples);
+
+        for (int lane = 1; lane < numChannels; ++lane)
+            range = range.getUnionWith (juce::FloatVectorOperations::findMinAndMax (delays + lane * m_maxSpanSize, numSamples));
+
+        auto longestSpan = static_cast<int> (range.getStart()) - 3;
+        windowLength = numSamples + static_cast<int> (std::ceil (range.getLength())) + 5;
+
+        if (numSamples <= longestSpan && windowLength <= guardSize)
+            break;
+
+        numSamples = juce::jmax (1, juce::jmin (numSamples / 2, longestSpan));
+    }
+
+    // Positions are relative to a window of frames starting one sample before the oldest tap
+    auto windowOffset = static_cast<int> (std::ceil (range.getEnd())) + 1;
+    auto* storedWindow = ring.getReadPointer (firstChannel, ring.wrap (writePosition - windowOffset));
+    const SampleType* window;
+
+    if constexpr (isDirect)
+    {
+        window = storedWindow;
+    }
+    else
+    {
+        jassert (windowLength <= m_maxSpanSize);
+        auto* decoded = m_scratch.getWritePointer (decodedWindow);
+        m_kernels->decodeHalf (storedWindow, 1, decoded, windowLength * lanes);
+        window = decoded;
+    }
+
+    auto* readPositions = m_scratch.getWritePointer (positions);
+
+    for (int lane = 0; lane < numChannels; ++lane)
+        for (int i = 0; i < numSamples; ++i)
+            readPositions[i * lanes + lane] = (static_cast<SampleType> (windowOffset) - delays[lane * m_maxSpanSize + i]) + static_cast<SampleType> (i);
+
+    // The silent lanes read their own silence at the start of the window
+    for (int lane = numChannels; lane < lanes; ++lane)
+        for (int i = 0; i < numSamples; ++i)
+            readPositions[i * lanes + lane] = static_cast<SampleType> (1 + i);
+
+    auto* tapBefore = m_scratch.getWritePointer (before);
+    auto* tapAt = m_scratch.getWritePointer (at);
+    auto* tapAfter = m_scratch.getWritePointer (after);
+    auto* tapAfterNext = m_scratch.getWritePointer (afterNext);
+    auto* tapFraction = m_scratch.getWritePointer (fraction);
+
+    m_kernels->gatherLanes (window, readPositions, tapBefore, tapAt, tapAfter, tapAfterNext, tapFraction, numSamples);
+    m_kernels->interpolate[static_cast<int> (interpolation)] (tapBefore, tapAt, tapAfter, tapAfterNext, tapFraction,
+                                                              m_scratch.getWritePointer (output), numSamples * lanes);
+
+    return numSamples;
+}
+
+//==============================================================================
+template class LanedReadHead<float>;
+template class LanedReadHead<double>;
+
+template int LanedReadHead<float>::read<Interpolation::linear> (const DelayRingBuffer<float>&, int, int, int, const float* const*, int) noexcept;
+template int LanedReadHead<float>::read<Interpolation::lagrange3> (const DelayRingBuffer<float>&, int, int, int, const float* const*, int) noexcept;
+template int LanedReadHead<float>::read<Interpolation::hermite> (const DelayRingBuffer<float>&, int, int, int, const float* const*, int) noexcept;
+template int LanedReadHead<float>::read<Interpolation::linear> (const DelayRingBuffer<HalfFloat::Bits>&, int, int, int, const float* const*, int) noexcept;
+template int LanedReadHead<float>::read<Interpolation::lagrange3> (const DelayRingBuffer<HalfFloat::Bits>&, int, int, int, const float* const*, int) noexcept;
+template int LanedReadHead<float>::read<Interpolation::hermite> (const DelayRingBuffer<HalfFloat::Bits>&, int, int, int, const float* const*, int) noexcept;
+template int LanedReadHead<double>::read<Interpolation::linear> (const DelayRingBuffer<double>&, int, int, int, const float* const*, int) noexcept;
+template int LanedReadHead<double>::read<Interpolation::lagrange3> (const DelayRingBuffer<double>&, int, int, int, const float* const*, int) noexcept;
+template int LanedReadHead<double>::read<Interpolation::hermite> (const DelayRingBuffer<double>&, int, int, int, const float* const*, int) noexcept;
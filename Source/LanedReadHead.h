@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    LanedReadHead.h
+    Created: 24 Oct 2026 11:02:51am
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DelayKernels.h"
+#include "DelayRingBuffer.h"
+#include "HalfFloat.h"
+#include "KernelDispatch.h"
+
+//==============================================================================
+/**
+    Reads one group of DelayKernels::channelLanes channels of a laned
+    DelayRingBuffer at per-channel, per-sample fractional delays.
+
+    It is FractionalReadHead across channels rather than along one: the
+    group's frames are read as one window, and every sample's read positions
+    are packed lane by lane, so gatherLanes and the interpolator handle all
+    of the group's channels in the same vectors. The output stays in laned
+    frames for the processor's readMixWriteLanes.
+
+    The span is cut the same way as FractionalReadHead's, by the shortest
+    and the spread of all the group's delays. A half-precision ring is
+    decoded one window of frames at a time.
+
+    SampleType is the processing precision, float or double.
+*/
+template <typename SampleType>
+class LanedReadHead
+{
+public:
+    LanedReadHead() = default;
+
+    /** Shortest delay the head will read, so that the interpolator taps can't reach the write head. */
+    static constexpr float minimumDelay = 4.0f;
+
+    /** Allocates scratch for spans of up to maxSpanSize samples, to be read
+        with the given kernels. Not real-time safe.
+    */
+    void prepare (int maxSpanSize, const KernelDispatch::Table& kernels);
+
+    /** Reads the delayed frames of the group starting at channel firstChannel
+        for the span starting at writePosition, with delaySamples[lane][i] the
+        delay of the i-th sample of each of its numChannels channels. Returns
+        how many of the numSamples were produced; they are available from
+        getOutput(), DelayKernels::channelLanes to a frame.
+    */
+    template <Interpolation interpolation, typename StorageType>
+    int read (const DelayRingBuffer<StorageType>& ring, int firstChannel, int numChannels, int writePosition,
+              const float* const* delaySamples, int numSamples) noexcept;
+
+    const SampleType* getOutput() const noexcept    { return m_scratch.getReadPointer (output); }
+
+private:
+    static constexpr int lanes = DelayKernels::channelLanes;
+
+    enum Scratch { clippedDelays, positions, before, at, after, afterNext, fraction, output, decodedWindow, numScratch };
+
+    juce::AudioBuffer<SampleType> m_scratch;
+    int m_maxSpanSize = 0;
+    const KernelDispatch::Kernels<SampleType>* m_kernels = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (LanedReadHead)
+};
@@ -0,0 +1,225 @@
+/*
+  ==============================================================================
+
+    MultiTapEngine.cpp
+    Created: 18 Oct 2026 4:05:22pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#include "MultiTapEngine.h"
+
+//==============================================================================
+void MultiTapEngine::prepare (int maxSpanSize, float maxDelaySamples, const KernelDispatch::Table& kernels)
+{
+    m_kernels = &kernels;
+    m_maxDelay = maxDelaySamples;
+    m_maxSpanSize = juce::jmax (1, maxSpanSize);
+
+    // Every row has room for a window or a span's worth of lanes for the whole bank
+    m_scratch.setSize (numScratch, maxTaps * (m_maxSpanSize + windowPadding));
+    m_scratch.clear();
+    m_doubleScratch.setSize (numScratch, maxTaps * (m_maxSpanSize + windowPadding));
+    m_doubleScratch.clear();
+}
+
+void MultiTapEngine::resetMeters() noexcept
+{
+    std::fill (std::begin (m_tapPeaks), std::end (m_tapPeaks), 0.0f);
+    m_sumMeter.reset();
+}
+
+void MultiTapEngine::setNumTaps (int newNumTaps) noexcept
+{
+    m_numTaps = juce::jlimit (0, maxTaps, newNumTaps);
+}
+
+void MultiTapEngine::setTap (int index, float delaySamples, float gain, float pan) noexcept
+{
+    jassert (juce::isPositiveAndBelow (index, maxTaps));
+
+    m_delays[index] = juce::jmin (delaySamples, m_maxDelay);
+    m_gains[index] = gain;
+    m_pans[index] = juce::jlimit (-1.0f, 1.0f, pan);
+}
+
+void MultiTapEngine::setEchoLayout (int numTaps, float spacingSamples, float decay, float width) noexcept
+{
+    setNumTaps (numTaps);
+
+    // TAPS times DELAYTIME can be far longer than the line, which only holds DELAYTIME plus STEREO
+    if (m_numTaps > 0)
+        spacingSamples = juce::jmin (spacingSamples, m_maxDelay / static_cast<float> (m_numTaps));
+
+    float gain = 1.0f;
+
+    for (int tap = 0; tap < m_numTaps; ++tap)
+    {
+        auto side = (tap % 2 == 0) ? 1.0f : -1.0f;
+        auto spread = width * static_cast<float> (tap + 1) / static_cast<float> (m_numTaps);
+
+        setTap (tap, spacingSamples * static_cast<float> (tap + 1), gain, side * spread);
+        gain *= decay;
+    }
+}
+
+float MultiTapEngine::getLongestDelay() const noexcept
+{
+    float longest = 0.0f;
+
+    for (int tap = 0; tap < m_numTaps; ++tap)
+        longest = juce::jmax (longest, m_delays[tap]);
+
+    return longest;
+}
+
+void MultiTapEngine::updateChannelGains (float side) noexcept
+{
+    // Equal-power pan law; left speakers take the cosine half, right ones the sine half,
+    // and centre or non-directional channels hear every tap at full gain
+    for (int tap = 0; tap < m_numTaps; ++tap)
+    {
+        if (side == 0.0f)
+        {
+            m_channelGains[tap] = m_gains[tap];
+            continue;
+        }
+
+        auto angle = (m_pans[tap] + 1.0f) * juce::MathConstants<float>::pi * 0.25f;
+        m_channelGains[tap] = m_gains[tap] * (side < 0.0f ? std::cos (angle) : std::sin (angle));
+    }
+}
+
+template <typename SampleType, typename StorageType>
+void MultiTapEngine::processChannel (DelayRingBuffer<StorageType>& ring, int channel, float side, Interpolation interpolation,
+                                     SampleType* io, const float* wetGain, int numSamples) noexcept
+{
+    // A ring in the processing precision is copied from; a half-precision one is decoded
+    constexpr auto isDirect = std::is_same_v<StorageType, SampleType>;
+
+    updateChannelGains (side);
+
+    auto& kernels = m_kernels->get<SampleType>();
+    auto& scratch = getScratch<SampleType>();
+    auto maxSpan = juce::jmin (ring.getGuardSize(), m_maxSpanSize);
+    auto maxDelay = static_cast<float> (ring.getCapacity() - ring.getGuardSize() - windowPadding);
+    auto stride = ring.getStride();
+
+    // Only the taps that can be heard take a lane. A tap further back than the line is long
+    // has nothing to play, and silent lanes fill up the last vector
+    int laneTaps[maxTaps];
+    int numActive = 0;
+    auto* gains = scratch.getWritePointer (gainScratch);
+
+    for (int tap = 0; tap < m_numTaps; ++tap)
+    {
+        if (m_channelGains[tap] == 0.0f || m_delays[tap] > maxDelay)
+            continue;
+
+        gains[numActive] = static_cast<SampleType> (m_channelGains[tap]);
+        laneTaps[numActive++] = tap;
+    }
+
+    auto numLanes = (numActive + DelayKernels::tapLanes - 1) / DelayKernels::tapLanes * DelayKernels::tapLanes;
+
+    for (int lane = numActive; lane < numLanes; ++lane)
+        gains[lane] = 0;
+
+    auto* windows = scratch.getWritePointer (windowScratch);
+    auto* positions = scratch.getWritePointer (positionScratch);
+    auto* before = scratch.getWritePointer (beforeScratch);
+    auto* at = scratch.getWritePointer (atScratch);
+    auto* after = scratch.getWritePointer (afterScratch);
+    auto* afterNext = scratch.getWritePointer (afterNextScratch);
+    auto* fraction = scratch.getWritePointer (fractionScratch);
+    auto* taps = scratch.getWritePointer (tapScratch);
+    auto* wet = scratch.getWritePointer (wetScratch);
+
+    // Copies a run of one channel out of the ring, split where it wraps
+    auto load = [&ring, &kernels, channel, stride] (int start, SampleType* destination, int length)
+    {
+        for (int done = 0; done < length;)
+        {
+            auto position = ring.wrap (start + done);
+            auto count = juce::jmin (length - done, ring.getCapacity() - position);
+            auto* source = ring.getReadPointer (channel, position);
+
+            if constexpr (! isDirect)
+                kernels.decodeHalf (source, stride, destination + done, count);
+            else if (stride == 1)
+                juce::FloatVectorOperations::copy (destination + done, source, count);
+            else
+                for (int i = 0; i < count; ++i)
+                    destination[done + i] = source[i * stride];
+
+            done += count;
+        }
+    };
+
+    for (int done = 0; done < numSamples;)
+    {
+        auto span = juce::jmin (numSamples - done, maxSpan);
+        auto writePosition = ring.wrap (ring.getWritePosition() + done);
+
+        // The input goes in first: nothing recirculates, so a tap shorter than the span
+        // can read samples of this very span
+        auto* destination = ring.getWritePointer (channel, writePosition);
+
+        if constexpr (! isDirect)
+            kernels.encodeHalf (io + done, destination, stride, span);
+        else if (stride == 1)
+            juce::FloatVectorOperations::copy (destination, io + done, span);
+        else
+            for (int i = 0; i < span; ++i)
+                destination[i * stride] = io[done + i];
+
+        ring.mirror (channel, writePosition, span);
+
+        if (numActive == 0)
+        {
+            done += span;
+            continue;
+        }
+
+        // Each lane's window starts two samples before its oldest read, so sample i of
+        // the span reads at i + 2 - fraction in it
+        auto windowLength = span + windowPadding;
+
+        for (int lane = 0; lane < numActive; ++lane)
+        {
+            auto delay = juce::jmax (minimumDelay, m_delays[laneTaps[lane]]);
+            auto whole = static_cast<int> (delay);
+            auto* window = windows + lane * windowLength;
+
+            load (writePosition - whole - 2, window, windowLength);
+
+            // The window holds every sample the tap reads, so its peak is the tap's
+            auto range = juce::FloatVectorOperations::findMinAndMax (window + 1, span + 1);
+            auto peak = static_cast<float> (juce::jmax (-range.getStart(), range.getEnd()) * std::abs (gains[lane]));
+            m_tapPeaks[laneTaps[lane]] = juce::jmax (m_tapPeaks[laneTaps[lane]], peak);
+
+            auto first = static_cast<SampleType> (lane * windowLength + 2) - static_cast<SampleType> (delay - static_cast<float> (whole));
+
+            for (int i = 0; i < span; ++i)
+                positions[i * numLanes + lane] = first + static_cast<SampleType> (i);
+        }
+
+        // The silent lanes read the first window, which is always there
+        for (int lane = numActive; lane < numLanes; ++lane)
+            for (int i = 0; i < span; ++i)
+                positions[i * numLanes + lane] = static_cast<SampleType> (1 + i);
+
+        kernels.gatherTaps (windows, 1, positions, before, at, after, afterNext, fraction, span * numLanes);
+        kernels.interpolate[static_cast<int> (interpolation)] (before, at, after, afterNext, fraction, taps, span * numLanes);
+        kernels.sumTaps (taps, gains, numLanes, wet, span);
+        m_sumMeter.add (wet, span);
+        kernels.mixWet (io + done, wet, wetGain + done, span);
+
+        done += span;
+    }
+}
+
+template void MultiTapEngine::processChannel (DelayRingBuffer<float>&, int, float, Interpolation, float*, const float*, int) noexcept;
+template void MultiTapEngine::processChannel (DelayRingBuffer<HalfFloat::Bits>&, int, float, Interpolation, float*, const float*, int) noexcept;
+template void MultiTapEngine::processChannel (DelayRingBuffer<double>&, int, float, Interpolation, double*, const float*, int) noexcept;
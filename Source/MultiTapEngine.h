@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+    MultiTapEngine.h
+    Created: 18 Oct 2026 4:05:22pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DelayRingBuffer.h"
+#include "HalfFloat.h"
+#include "KernelDispatch.h"
+#include "TelemetryBus.h"
+
+//==============================================================================
+/**
+    Up to maxTaps read heads on the shared delay line, each with its own
+    time, gain and pan.
+
+    The tap settings are kept as structure-of-arrays, and the per-channel tap
+    gains (gain * pan law) are folded once per block. The taps then run in
+    SIMD lanes: each sample's read positions are packed tap by tap, the
+    dispatched gatherTaps and interpolate kernels read and interpolate
+    every tap of every sample in one pass, and sumTaps weights and sums the
+    lanes of each sample. The lanes come in vectors of
+    DelayKernels::tapLanes, so one tap costs as much as eight, and sixteen
+    only twice that. Everything that doesn't depend on the tap (the ring
+    write, the wet/dry mix) is paid once per channel.
+
+    Each tap reads a short window of the ring, a span plus the interpolator's
+    neighbours, copied (or decoded, for a half-precision ring) next to the
+    others'. The read positions are relative to those windows, so they stay
+    small enough to keep the fractions exact in float.
+
+    The taps don't recirculate: each one is an echo of the input, the way the
+    editor draws them. Each tap's peak and the taps' sum are metered as they
+    are made, for the visualiser.
+*/
+class MultiTapEngine
+{
+public:
+    MultiTapEngine() = default;
+
+    static constexpr int maxTaps = 16;
+
+    /** Allocates the wet scratch for spans of up to maxSpanSize samples, and
+        takes the kernels to mix with. No tap reaches further back than
+        maxDelaySamples, which the delay line has to hold. Not real-time safe.
+    */
+    void prepare (int maxSpanSize, float maxDelaySamples, const KernelDispatch::Table& kernels);
+
+    void setNumTaps (int newNumTaps) noexcept;
+    int getNumTaps() const noexcept     { return m_numTaps; }
+
+    /** Sets one tap. pan runs from -1 (left) to 1 (right). The delay is cut to the reach given to prepare(). */
+    void setTap (int index, float delaySamples, float gain, float pan) noexcept;
+
+    /** Spreads the taps the way the editor draws them: evenly spaced by
+        spacingSamples, decaying by decay per tap and alternating sides with a
+        spread that grows to width (0..1) for the last tap. Taps that would
+        reach past the line close up so the last one lands at its end.
+    */
+    void setEchoLayout (int numTaps, float spacingSamples, float decay, float width) noexcept;
+
+    /** The delay of the furthest tap in use, in samples. */
+    float getLongestDelay() const noexcept;
+
+    /** Writes one channel of input into the ring buffer and adds the taps to it in place,
+        read with the given interpolator. side is the speaker's side from SpeakerLayout:
+        -1 left, 1 right, 0 centre. SampleType is the processing precision; a double ring
+        goes with double samples.
+    */
+    template <typename SampleType, typename StorageType>
+    void processChannel (DelayRingBuffer<StorageType>& ring, int channel, float side, Interpolation interpolation,
+                         SampleType* io, const float* wetGain, int numSamples) noexcept;
+
+    /** Each tap's peak after its channel gain, and the level of the taps' sum, since resetMeters(). */
+    const float* getTapPeaks() const noexcept       { return m_tapPeaks; }
+    const LevelMeter& getSumMeter() const noexcept  { return m_sumMeter; }
+    void resetMeters() noexcept;
+
+private:
+    // Shortest delay a tap reads, so that its interpolator's neighbours are all written already
+    static constexpr float minimumDelay = 4.0f;
+
+    // A tap's window holds its span, one sample before it and three after
+    static constexpr int windowPadding = 5;
+
+    static_assert (maxTaps % DelayKernels::tapLanes == 0, "the tap bank fills whole vectors");
+
+    void updateChannelGains (float side) noexcept;
+
+    // Tap bank, one array per field
+    float m_delays[maxTaps] = {};
+    float m_gains[maxTaps] = {};
+    float m_pans[maxTaps] = {};
+    float m_channelGains[maxTaps] = {};
+
+    float m_tapPeaks[maxTaps] = {};
+    LevelMeter m_sumMeter;
+
+    int m_numTaps = 0;
+    float m_maxDelay = 0.0f;
+    int m_maxSpanSize = 0;
+
+    // Lane-packed scratch: row i * numLanes + lane of the tap rows is one tap of one sample
+    enum { windowScratch, positionScratch, beforeScratch, atScratch, afterScratch, afterNextScratch,
+           fractionScratch, tapScratch, gainScratch, wetScratch, numScratch };
+    juce::AudioBuffer<float> m_scratch;
+    juce::AudioBuffer<double> m_doubleScratch;
+
+    template <typename SampleType>
+    juce::AudioBuffer<SampleType>& getScratch() noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, float>)
+            return m_scratch;
+        else
+            return m_doubleScratch;
+    }
+
+    const KernelDispatch::Table* m_kernels = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (MultiTapEngine)
+};
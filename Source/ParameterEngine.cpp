@@ -0,0 +1,272 @@
+/*
+  ==============================================================================
+
+    ParameterEngine.cpp
+    Created: 18 Oct 2026 1:14:52pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#include "ParameterEngine.h"
+
+//==============================================================================
+ParameterEngine::ParameterEngine (juce::AudioProcessorValueTreeState& apvts)
+    : m_dryWet (apvts.getRawParameterValue ("DRYWET")),
+      m_delayTime (apvts.getRawParameterValue ("DELAYTIME")),
+      m_feedback (apvts.getRawParameterValue ("FEEDBACK")),
+      m_stereo (apvts.getRawParameterValue ("STEREO")),
+      m_interpolation (apvts.getRawParameterValue ("INTERP")),
+      m_mode (apvts.getRawParameterValue ("MODE")),
+      m_numTaps (apvts.getRawParameterValue ("TAPS")),
+      m_tapLayout (apvts.getRawParameterValue ("TAPLAYOUT")),
+      m_lowCut (apvts.getRawParameterValue ("LOWCUT")),
+      m_highCut (apvts.getRawParameterValue ("HIGHCUT")),
+      m_smear (apvts.getRawParameterValue ("SMEAR"))
+{
+    jassert (m_dryWet != nullptr && m_delayTime != nullptr && m_feedback != nullptr && m_stereo != nullptr
+             && m_interpolation != nullptr && m_mode != nullptr && m_numTaps != nullptr
+             && m_lowCut != nullptr && m_highCut != nullptr && m_smear != nullptr && m_tapLayout != nullptr);
+
+    for (int tap = 0; tap < MultiTapEngine::maxTaps; ++tap)
+    {
+        auto prefix = "TAP" + juce::String (tap + 1);
+        m_taps[tapTime][tap] = apvts.getRawParameterValue (prefix + "TIME");
+        m_taps[tapGain][tap] = apvts.getRawParameterValue (prefix + "GAIN");
+        m_taps[tapPan][tap] = apvts.getRawParameterValue (prefix + "PAN");
+
+        jassert (m_taps[tapTime][tap] != nullptr && m_taps[tapGain][tap] != nullptr && m_taps[tapPan][tap] != nullptr);
+    }
+}
+
+void ParameterEngine::prepare (double sampleRate, int maxBlockSize, const SpeakerLayout& layout)
+{
+    m_samplesPerMs = sampleRate / 1000.0;
+    m_numChannels = layout.getNumChannels();
+    m_ramps.setSize (numRamps + juce::jmax (1, m_numChannels), juce::jmax (1, maxBlockSize));
+
+    for (int channel = 0; channel < m_numChannels; ++channel)
+        m_channelOffsets[channel] = layout.getOffset (channel);
+
+    // Gains follow automation quickly, delay times glide a little slower
+    m_smoothers[wetGainRamp].reset (sampleRate, 0.02);
+    m_smoothers[feedbackRamp].reset (sampleRate, 0.02);
+    m_smoothers[delayRamp].reset (sampleRate, 0.05);
+    m_smoothers[stereoRamp].reset (sampleRate, 0.05);
+    m_smoothers[smearRamp].reset (sampleRate, 0.02);
+
+    for (int tap = 0; tap < MultiTapEngine::maxTaps; ++tap)
+    {
+        m_tapSmoothers[tapTime][tap].reset (sampleRate, 0.05);
+        m_tapSmoothers[tapGain][tap].reset (sampleRate, 0.02);
+        m_tapSmoothers[tapPan][tap].reset (sampleRate, 0.02);
+    }
+
+    m_wetFade.reset (sampleRate, 0.01);
+    m_wetFade.setCurrentAndTargetValue (1.0f);
+    m_modeFade.reset (sampleRate, 0.01);
+    m_modeFade.setCurrentAndTargetValue (1.0f);
+
+    jumpToTargets();
+}
+
+void ParameterEngine::jumpToTargets() noexcept
+{
+    auto snapshot = getSnapshot();
+    setTargets (snapshot);
+
+    for (auto& smoother : m_smoothers)
+        smoother.setCurrentAndTargetValue (smoother.getTargetValue());
+
+    for (int field = 0; field < numTapFields; ++field)
+    {
+        for (int tap = 0; tap < MultiTapEngine::maxTaps; ++tap)
+        {
+            auto& smoother = m_tapSmoothers[field][tap];
+            smoother.setCurrentAndTargetValue (smoother.getTargetValue());
+            m_tapValues[field][tap] = smoother.getCurrentValue();
+        }
+    }
+
+    // The wet is silent whenever this is called, so a mode switch needs no fade
+    m_modeChanged = m_modeChanged || ! sharesLines (snapshot.mode, m_activeMode);
+    m_activeMode = snapshot.mode;
+    m_modeFade.setCurrentAndTargetValue (1.0f);
+}
+
+void ParameterEngine::updateMode (DelayMode target) noexcept
+{
+    // Single and multi-tap read the same line, so they switch on the spot. The diffuse
+    // network keeps its repeats in lines of its own, so switching to or from it fades
+    // the old mode out, clears the lines and fades the new one in
+    if (sharesLines (target, m_activeMode))
+    {
+        m_activeMode = target;
+
+        if (m_modeFade.getTargetValue() == 0.0f)
+            m_modeFade.setTargetValue (1.0f);     // MODE went back before the fade was over
+    }
+    else if (m_modeFade.getTargetValue() != 0.0f)
+    {
+        m_modeFade.setTargetValue (0.0f);
+    }
+    else if (! m_modeFade.isSmoothing())
+    {
+        m_activeMode = target;
+        m_modeChanged = true;
+        m_modeFade.setTargetValue (1.0f);
+    }
+}
+
+void ParameterEngine::setWetAudible (bool shouldBeAudible) noexcept
+{
+    m_wetFade.setTargetValue (shouldBeAudible ? 1.0f : 0.0f);
+}
+
+ParameterSnapshot ParameterEngine::getSnapshot() const noexcept
+{
+    ParameterSnapshot snapshot;
+    snapshot.wetGain = juce::jmap (m_dryWet->load (std::memory_order_relaxed), 0.0f, 100.0f, 0.0f, 1.0f);
+    snapshot.feedback = m_feedback->load (std::memory_order_relaxed);
+    snapshot.delayTimeMs = m_delayTime->load (std::memory_order_relaxed);
+    snapshot.stereoMs = m_stereo->load (std::memory_order_relaxed);
+    snapshot.interpolation = static_cast<Interpolation> (juce::roundToInt (m_interpolation->load (std::memory_order_relaxed)));
+    snapshot.mode = static_cast<DelayMode> (juce::roundToInt (m_mode->load (std::memory_order_relaxed)));
+    snapshot.numTaps = juce::roundToInt (m_numTaps->load (std::memory_order_relaxed));
+    snapshot.tapLayout = static_cast<TapLayout> (juce::roundToInt (m_tapLayout->load (std::memory_order_relaxed)));
+
+    for (int tap = 0; tap < MultiTapEngine::maxTaps; ++tap)
+    {
+        snapshot.tapTimesMs[tap] = m_taps[tapTime][tap]->load (std::memory_order_relaxed);
+        snapshot.tapGains[tap] = m_taps[tapGain][tap]->load (std::memory_order_relaxed);
+        snapshot.tapPans[tap] = m_taps[tapPan][tap]->load (std::memory_order_relaxed);
+    }
+
+    snapshot.lowCutHz = m_lowCut->load (std::memory_order_relaxed);
+    snapshot.highCutHz = m_highCut->load (std::memory_order_relaxed);
+    snapshot.smear = juce::jmap (m_smear->load (std::memory_order_relaxed), 0.0f, 100.0f, 0.0f, 1.0f);
+    return snapshot;
+}
+
+void ParameterEngine::setTargets (const ParameterSnapshot& snapshot) noexcept
+{
+    m_smoothers[wetGainRamp].setTargetValue (snapshot.wetGain);
+    m_smoothers[feedbackRamp].setTargetValue (snapshot.feedback);
+    m_smoothers[delayRamp].setTargetValue (static_cast<float> (snapshot.delayTimeMs * m_samplesPerMs));
+    m_smoothers[stereoRamp].setTargetValue (static_cast<float> (snapshot.stereoMs * m_samplesPerMs));
+    m_smoothers[smearRamp].setTargetValue (snapshot.smear);
+
+    for (int tap = 0; tap < MultiTapEngine::maxTaps; ++tap)
+    {
+        m_tapSmoothers[tapTime][tap].setTargetValue (static_cast<float> (snapshot.tapTimesMs[tap] * m_samplesPerMs));
+        m_tapSmoothers[tapGain][tap].setTargetValue (snapshot.tapGains[tap]);
+        m_tapSmoothers[tapPan][tap].setTargetValue (snapshot.tapPans[tap]);
+    }
+}
+
+SmoothedParameters ParameterEngine::process (int numSamples) noexcept
+{
+    jassert (numSamples <= m_ramps.getNumSamples());
+
+    auto snapshot = getSnapshot();
+    setTargets (snapshot);
+    updateMode (snapshot.mode);
+
+    for (int ramp = 0; ramp < numRamps; ++ramp)
+    {
+        auto& smoother = m_smoothers[ramp];
+        auto* values = m_ramps.getWritePointer (ramp);
+
+        // Settled parameters are a flat fill; only a moving one pays for the ramp
+        if (! smoother.isSmoothing())
+        {
+            juce::FloatVectorOperations::fill (values, smoother.getTargetValue(), numSamples);
+            continue;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+            values[i] = smoother.getNextValue();
+    }
+
+    // The recall fade scales the wet ramp; at rest it is either a no-op or silence
+    if (m_wetFade.isSmoothing())
+    {
+        auto* wetGain = m_ramps.getWritePointer (wetGainRamp);
+
+        for (int i = 0; i < numSamples; ++i)
+            wetGain[i] *= m_wetFade.getNextValue();
+    }
+    else if (m_wetFade.getTargetValue() == 0.0f)
+    {
+        juce::FloatVectorOperations::clear (m_ramps.getWritePointer (wetGainRamp), numSamples);
+    }
+
+    // The mode fade scales it the same way, on top
+    if (m_modeFade.isSmoothing())
+    {
+        auto* wetGain = m_ramps.getWritePointer (wetGainRamp);
+
+        for (int i = 0; i < numSamples; ++i)
+            wetGain[i] *= m_modeFade.getNextValue();
+    }
+    else if (m_modeFade.getTargetValue() == 0.0f)
+    {
+        juce::FloatVectorOperations::clear (m_ramps.getWritePointer (wetGainRamp), numSamples);
+    }
+
+    // The taps take the value they reach by the end of the block
+    for (int field = 0; field < numTapFields; ++field)
+        for (int tap = 0; tap < MultiTapEngine::maxTaps; ++tap)
+            if (m_tapSmoothers[field][tap].isSmoothing())
+                m_tapValues[field][tap] = m_tapSmoothers[field][tap].skip (numSamples);
+            else
+                m_tapValues[field][tap] = m_tapSmoothers[field][tap].getTargetValue();
+
+    auto* delays = m_ramps.getReadPointer (delayRamp);
+    auto* stereo = m_ramps.getReadPointer (stereoRamp);
+
+    for (int channel = 0; channel < m_numChannels; ++channel)
+    {
+        auto offset = m_channelOffsets[channel];
+        m_channelDelays[channel] = nullptr;
+
+        if (offset == 0.0f)
+        {
+            m_channelDelays[channel] = delays;
+            continue;
+        }
+
+        // A surround layout has at most three distinct offsets, so most channels reuse a row
+        for (int other = 0; other < channel; ++other)
+            if (m_channelOffsets[other] == offset)
+                m_channelDelays[channel] = m_channelDelays[other];
+
+        if (m_channelDelays[channel] == nullptr)
+        {
+            auto* row = m_ramps.getWritePointer (firstChannelDelayRow + channel);
+            juce::FloatVectorOperations::copy (row, delays, numSamples);
+            juce::FloatVectorOperations::addWithMultiply (row, stereo, offset, numSamples);
+            m_channelDelays[channel] = row;
+        }
+    }
+
+    SmoothedParameters parameters;
+    parameters.wetGain = m_ramps.getReadPointer (wetGainRamp);
+    parameters.feedback = m_ramps.getReadPointer (feedbackRamp);
+    parameters.delaySamples = m_ramps.getReadPointer (delayRamp);
+    parameters.stereoSamples = m_ramps.getReadPointer (stereoRamp);
+    parameters.channelDelaySamples = m_channelDelays;
+    parameters.smear = m_ramps.getReadPointer (smearRamp);
+    parameters.interpolation = snapshot.interpolation;
+    parameters.mode = m_activeMode;
+    parameters.modeChanged = std::exchange (m_modeChanged, false);
+    parameters.numTaps = snapshot.numTaps;
+    parameters.tapLayout = snapshot.tapLayout;
+    parameters.tapDelaySamples = m_tapValues[tapTime];
+    parameters.tapGains = m_tapValues[tapGain];
+    parameters.tapPans = m_tapValues[tapPan];
+    parameters.lowCutHz = snapshot.lowCutHz;
+    parameters.highCutHz = snapshot.highCutHz;
+    parameters.numSamples = numSamples;
+    return parameters;
+}
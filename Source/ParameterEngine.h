@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+    ParameterEngine.h
+    Created: 18 Oct 2026 1:14:52pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DelayKernels.h"
+#include "MultiTapEngine.h"
+#include "SpeakerLayout.h"
+
+/** Delay engines, in the order of the MODE parameter. */
+enum class DelayMode
+{
+    single,
+    multiTap,
+    diffuse
+};
+
+/** Where the multi-tap taps come from, in the order of the TAPLAYOUT parameter. */
+enum class TapLayout
+{
+    echoes,     // DELAYTIME apart, fading by FEEDBACK, spread by STEREO, as the editor draws them
+    manual      // each tap's own TAPnTIME, TAPnGAIN and TAPnPAN
+};
+
+//==============================================================================
+/** Target values of the DSP parameters, read once per block. */
+struct ParameterSnapshot
+{
+    float wetGain = 0.0f;       // DRYWET mapped to 0..1
+    float feedback = 0.0f;
+    float delayTimeMs = 0.0f;
+    float stereoMs = 0.0f;
+    Interpolation interpolation = Interpolation::linear;
+    DelayMode mode = DelayMode::single;
+    int numTaps = 1;
+    TapLayout tapLayout = TapLayout::echoes;
+    float tapTimesMs[MultiTapEngine::maxTaps] = {};
+    float tapGains[MultiTapEngine::maxTaps] = {};
+    float tapPans[MultiTapEngine::maxTaps] = {};
+    float lowCutHz = 20.0f;
+    float highCutHz = 20000.0f;
+    float smear = 0.0f;         // SMEAR mapped to 0..1
+};
+
+/** Per-sample smoothed values for the current block, all numSamples long. */
+struct SmoothedParameters
+{
+    const float* wetGain = nullptr;
+    const float* feedback = nullptr;
+    const float* delaySamples = nullptr;
+    const float* stereoSamples = nullptr;
+    const float* const* channelDelaySamples = nullptr;  // delaySamples plus each speaker's share of stereoSamples
+    const float* smear = nullptr;
+    Interpolation interpolation = Interpolation::linear;
+    DelayMode mode = DelayMode::single;
+    bool modeChanged = false;   // switched to or from Diffuse: the lines still hold the old mode's repeats
+    int numTaps = 1;
+    TapLayout tapLayout = TapLayout::echoes;
+    const float* tapDelaySamples = nullptr;             // maxTaps long, smoothed once per block
+    const float* tapGains = nullptr;
+    const float* tapPans = nullptr;
+    float lowCutHz = 20.0f;
+    float highCutHz = 20000.0f;
+    int numSamples = 0;
+
+    /** Delay of a channel: DELAYTIME plus the speaker's offset (see SpeakerLayout). */
+    const float* getDelays (int channel) const noexcept
+    {
+        return channelDelaySamples[channel];
+    }
+};
+
+//==============================================================================
+/**
+    Owns the audio thread's view of the APVTS parameters.
+
+    The atomic parameter pointers are resolved once on construction, so the
+    audio thread never looks a parameter up by name. Each block takes one
+    snapshot of the targets and renders per-sample ramps into preallocated
+    arrays, which the DSP reads through SmoothedParameters.
+*/
+class ParameterEngine
+{
+public:
+    explicit ParameterEngine (juce::AudioProcessorValueTreeState& apvts);
+
+    /** Allocates the ramp buffers and jumps the smoothers to the current values. */
+    void prepare (double sampleRate, int maxBlockSize, const SpeakerLayout& layout);
+
+    ParameterSnapshot getSnapshot() const noexcept;
+
+    /** Takes a snapshot and renders the next numSamples of smoothed values. */
+    SmoothedParameters process (int numSamples) noexcept;
+
+    /** Moves every ramp straight to the current parameter values, without smoothing. */
+    void jumpToTargets() noexcept;
+
+    /** Fades the wet gain out (false) or back in (true) over 10 ms, on top of DRYWET.
+        A preset recall switches the parameters while the wet path is faded out.
+        Switching MODE to or from Diffuse fades the wet the same way by itself.
+    */
+    void setWetAudible (bool shouldBeAudible) noexcept;
+
+    bool isWetFadedOut() const noexcept     { return m_wetFade.getTargetValue() == 0.0f && ! m_wetFade.isSmoothing(); }
+
+private:
+    static bool sharesLines (DelayMode a, DelayMode b) noexcept
+    {
+        return (a == DelayMode::diffuse) == (b == DelayMode::diffuse);
+    }
+
+    void updateMode (DelayMode target) noexcept;
+
+    enum Ramp { wetGainRamp, feedbackRamp, delayRamp, stereoRamp, smearRamp, numRamps };
+    enum { firstChannelDelayRow = numRamps };
+    enum TapField { tapTime, tapGain, tapPan, numTapFields };
+
+    void setTargets (const ParameterSnapshot& snapshot) noexcept;
+
+    std::atomic<float>* m_dryWet;
+    std::atomic<float>* m_delayTime;
+    std::atomic<float>* m_feedback;
+    std::atomic<float>* m_stereo;
+    std::atomic<float>* m_interpolation;
+    std::atomic<float>* m_mode;
+    std::atomic<float>* m_numTaps;
+    std::atomic<float>* m_tapLayout;
+    std::atomic<float>* m_taps[numTapFields][MultiTapEngine::maxTaps];
+    std::atomic<float>* m_lowCut;
+    std::atomic<float>* m_highCut;
+    std::atomic<float>* m_smear;
+
+    double m_samplesPerMs = 44.1;
+    juce::SmoothedValue<float> m_smoothers[numRamps];
+    juce::SmoothedValue<float> m_wetFade { 1.0f };
+    juce::AudioBuffer<float> m_ramps;
+
+    // The taps move once per block rather than per sample, like the echo layout they stand in for
+    juce::SmoothedValue<float> m_tapSmoothers[numTapFields][MultiTapEngine::maxTaps];
+    float m_tapValues[numTapFields][MultiTapEngine::maxTaps] = {};
+
+    // The mode the DSP runs, which trails MODE by a fade when it switches the lines
+    DelayMode m_activeMode = DelayMode::single;
+    juce::SmoothedValue<float> m_modeFade { 1.0f };
+    bool m_modeChanged = false;
+
+    // Per-channel delays; channels with the same offset share a row
+    int m_numChannels = 0;
+    float m_channelOffsets[SpeakerLayout::maxChannels] = {};
+    const float* m_channelDelays[SpeakerLayout::maxChannels] = {};
+
+    JUCE_DECLARE_NON_COPYABLE (ParameterEngine)
+};
@@ -0,0 +1,222 @@
+/*
+  ==============================================================================
+
+    PerformanceMonitor.cpp
+    Created: 19 Oct 2026 2:16:44pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#include "PerformanceMonitor.h"
+
+#if JUCE_INTEL
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <x86intrin.h>
+ #endif
+#endif
+
+//==============================================================================
+juce::uint64 PerformanceMonitor::getTicks() noexcept
+{
+   #if JUCE_INTEL
+    return static_cast<juce::uint64> (__rdtsc());
+   #else
+    return static_cast<juce::uint64> (juce::Time::getHighResolutionTicks());
+   #endif
+}
+
+double PerformanceMonitor::getTicksPerSecond()
+{
+   #if JUCE_INTEL
+    // The invariant TSC runs at a fixed rate, so one short measurement is enough
+    static const double ticksPerSecond = []
+    {
+        auto startTime = juce::Time::getHighResolutionTicks();
+        auto startTicks = getTicks();
+        juce::Thread::sleep (20);
+        auto elapsedTicks = getTicks() - startTicks;
+        auto elapsedSeconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - startTime);
+
+        return static_cast<double> (elapsedTicks) / elapsedSeconds;
+    }();
+
+    return ticksPerSecond;
+   #else
+    return static_cast<double> (juce::Time::getHighResolutionTicksPerSecond());
+   #endif
+}
+
+const char* PerformanceMonitor::getStageName (int stage) noexcept
+{
+    switch (stage)
+    {
+        case wholeBlock:        return "block";
+        case parameterStage:    return "parameters";
+        case readStage:         return "read";
+        case filterStage:       return "filter";
+        case writeStage:        return "write";
+        case multiTapStage:     return "multitap";
+        case diffuseStage:      return "diffuse";
+        case smearStage:        return "smear";
+        default:                return "";
+    }
+}
+
+void PerformanceMonitor::prepare (double sampleRate)
+{
+    m_sampleRate = sampleRate;
+    m_ticksPerSecond = getTicksPerSecond();
+    m_deadlineTicksPerSample = m_ticksPerSecond / sampleRate;
+    requestReset();
+}
+
+//==============================================================================
+void PerformanceMonitor::startBlock() noexcept
+{
+    if (m_resetRequested.exchange (false, std::memory_order_acquire))
+        clear();
+
+    std::fill (std::begin (m_blockTicks), std::end (m_blockTicks), juce::uint64 (0));
+    m_blockStart = getTicks();
+}
+
+void PerformanceMonitor::endBlock (int numSamples) noexcept
+{
+    m_blockTicks[wholeBlock] = getTicks() - m_blockStart;
+
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        auto ticks = m_blockTicks[stage];
+
+        // Stages a block never entered stay out of their histogram
+        if (ticks == 0 && stage != wholeBlock)
+            continue;
+
+        auto& atomics = m_stages[stage];
+        add (atomics.numBlocks, 1);
+        add (atomics.totalTicks, ticks);
+
+        if (ticks > atomics.maxTicks.load (std::memory_order_relaxed))
+            atomics.maxTicks.store (ticks, std::memory_order_relaxed);
+
+        int bin = 0;
+
+        for (auto remaining = ticks; remaining != 0 && bin < numBins - 1; remaining >>= 1)
+            ++bin;
+
+        add (atomics.bins[bin], 1);
+    }
+
+    add (m_numSamples, static_cast<juce::uint64> (numSamples));
+
+    auto load = static_cast<float> (static_cast<double> (m_blockTicks[wholeBlock]) / (m_deadlineTicksPerSample * juce::jmax (1, numSamples)));
+    m_lastLoad.store (load, std::memory_order_relaxed);
+
+    if (load > m_maxLoad.load (std::memory_order_relaxed))
+        m_maxLoad.store (load, std::memory_order_relaxed);
+
+    if (load > 1.0f)
+        add (m_numOverruns, 1);
+}
+
+void PerformanceMonitor::clear() noexcept
+{
+    for (auto& stage : m_stages)
+    {
+        stage.numBlocks.store (0, std::memory_order_relaxed);
+        stage.totalTicks.store (0, std::memory_order_relaxed);
+        stage.maxTicks.store (0, std::memory_order_relaxed);
+
+        for (auto& bin : stage.bins)
+            bin.store (0, std::memory_order_relaxed);
+    }
+
+    m_numSamples.store (0, std::memory_order_relaxed);
+    m_numOverruns.store (0, std::memory_order_relaxed);
+    m_lastLoad.store (0.0f, std::memory_order_relaxed);
+    m_maxLoad.store (0.0f, std::memory_order_relaxed);
+}
+
+//==============================================================================
+PerformanceMonitor::Statistics PerformanceMonitor::getStatistics() const noexcept
+{
+    // Fields are read one at a time, so a snapshot may straddle a block; fine for statistics
+    Statistics statistics;
+
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        auto& atomics = m_stages[stage];
+        auto& result = statistics.stages[stage];
+
+        result.numBlocks = atomics.numBlocks.load (std::memory_order_relaxed);
+        result.totalTicks = atomics.totalTicks.load (std::memory_order_relaxed);
+        result.maxTicks = atomics.maxTicks.load (std::memory_order_relaxed);
+
+        for (int bin = 0; bin < numBins; ++bin)
+            result.bins[bin] = atomics.bins[bin].load (std::memory_order_relaxed);
+    }
+
+    statistics.numSamples = m_numSamples.load (std::memory_order_relaxed);
+    statistics.numOverruns = m_numOverruns.load (std::memory_order_relaxed);
+    statistics.lastLoad = m_lastLoad.load (std::memory_order_relaxed);
+    statistics.maxLoad = m_maxLoad.load (std::memory_order_relaxed);
+    statistics.ticksPerSecond = m_ticksPerSecond;
+    return statistics;
+}
+
+double PerformanceMonitor::Statistics::getAverageLoad (double sampleRate) const noexcept
+{
+    if (numSamples == 0)
+        return 0.0;
+
+    auto busySeconds = static_cast<double> (stages[wholeBlock].totalTicks) / ticksPerSecond;
+    return busySeconds / (static_cast<double> (numSamples) / sampleRate);
+}
+
+double PerformanceMonitor::Statistics::getNanosPerSample (int stage) const noexcept
+{
+    if (numSamples == 0)
+        return 0.0;
+
+    return 1.0e9 * static_cast<double> (stages[stage].totalTicks) / ticksPerSecond / static_cast<double> (numSamples);
+}
+
+bool PerformanceMonitor::writeCsv (const juce::File& file) const
+{
+    auto statistics = getStatistics();
+    auto toMicros = [&] (double ticks) { return juce::String (1.0e6 * ticks / statistics.ticksPerSecond, 3); };
+
+    juce::String csv;
+    csv << "# sampleRate=" << m_sampleRate << ",samples=" << static_cast<juce::int64> (statistics.numSamples)
+        << ",overruns=" << static_cast<juce::int64> (statistics.numOverruns)
+        << ",averageLoad=" << juce::String (statistics.getAverageLoad (m_sampleRate), 4)
+        << ",maxLoad=" << juce::String (statistics.maxLoad, 4) << "\n";
+
+    csv << "stage,blocks,nsPerSample,meanMicros,maxMicros";
+
+    // Bin columns are labelled with their upper edge in microseconds
+    for (int bin = 0; bin < numBins; ++bin)
+        csv << ",<" << toMicros (std::ldexp (1.0, bin));
+
+    csv << "\n";
+
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        auto& result = statistics.stages[stage];
+        auto mean = result.numBlocks > 0 ? static_cast<double> (result.totalTicks) / static_cast<double> (result.numBlocks) : 0.0;
+
+        csv << getStageName (stage) << "," << static_cast<juce::int64> (result.numBlocks) << ","
+            << juce::String (statistics.getNanosPerSample (stage), 3) << ","
+            << toMicros (mean) << "," << toMicros (static_cast<double> (result.maxTicks));
+
+        for (auto count : result.bins)
+            csv << "," << static_cast<juce::int64> (count);
+
+        csv << "\n";
+    }
+
+    return file.replaceWithText (csv);
+}
@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    PerformanceMonitor.h
+    Created: 19 Oct 2026 2:16:44pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Always-on timing of processBlock and its stages.
+
+    The audio thread is the only writer: it reads the CPU's cycle counter
+    around each stage and folds the totals into log2-spaced histograms at the
+    end of the block with plain relaxed atomic stores, so recording is
+    wait-free. The message thread can read the statistics at any time for
+    display, or dump them to CSV, without stopping the audio thread.
+
+    Each block is also compared with its real-time deadline (numSamples /
+    sampleRate), so overruns show up without attaching a profiler.
+*/
+class PerformanceMonitor
+{
+public:
+    enum Stage
+    {
+        wholeBlock,
+        parameterStage,     // snapshot and smoothing
+        readStage,          // fractional read heads
+        filterStage,        // feedback tone filter
+        writeStage,         // fused mix and feedback write
+        multiTapStage,
+        diffuseStage,       // feedback delay network
+        smearStage,         // convolution of the wet signal
+        numStages
+    };
+
+    static constexpr int numBins = 48;      // bin n holds durations in [2^(n-1), 2^n) ticks
+
+    PerformanceMonitor() = default;
+
+    /** Cycle counter where the CPU has one, the high resolution clock otherwise. */
+    static juce::uint64 getTicks() noexcept;
+
+    /** Rate of getTicks(), calibrated once per process. Not real-time safe on first call. */
+    static double getTicksPerSecond();
+
+    static const char* getStageName (int stage) noexcept;
+
+    void prepare (double sampleRate);
+
+    //==============================================================================
+    // Audio thread
+    void startBlock() noexcept;
+    void addStageTicks (Stage stage, juce::uint64 ticks) noexcept     { m_blockTicks[stage] += ticks; }
+    void endBlock (int numSamples) noexcept;
+
+    class ScopedStage
+    {
+    public:
+        ScopedStage (PerformanceMonitor& monitor, Stage stage) noexcept
+            : m_monitor (monitor), m_stage (stage), m_start (getTicks()) {}
+
+        ~ScopedStage() noexcept     { m_monitor.addStageTicks (m_stage, getTicks() - m_start); }
+
+    private:
+        PerformanceMonitor& m_monitor;
+        Stage m_stage;
+        juce::uint64 m_start;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedStage)
+    };
+
+    //==============================================================================
+    // Message thread
+    struct StageStatistics
+    {
+        juce::uint64 numBlocks = 0;
+        juce::uint64 totalTicks = 0;
+        juce::uint64 maxTicks = 0;
+        juce::uint64 bins[numBins] = {};
+    };
+
+    struct Statistics
+    {
+        StageStatistics stages[numStages];
+        juce::uint64 numSamples = 0;
+        juce::uint64 numOverruns = 0;
+        float lastLoad = 0.0f;              // fraction of the deadline used by the latest block
+        float maxLoad = 0.0f;
+        double ticksPerSecond = 1.0;
+
+        double getAverageLoad (double sampleRate) const noexcept;
+        double getNanosPerSample (int stage) const noexcept;
+    };
+
+    Statistics getStatistics() const noexcept;
+
+    /** Asks the audio thread to clear the statistics at its next block. */
+    void requestReset() noexcept        { m_resetRequested = true; }
+
+    bool writeCsv (const juce::File& file) const;
+
+private:
+    struct AtomicStage
+    {
+        std::atomic<juce::uint64> numBlocks { 0 }, totalTicks { 0 }, maxTicks { 0 };
+        std::atomic<juce::uint64> bins[numBins] {};
+    };
+
+    // Single writer, so a relaxed load and store is a complete update
+    static void add (std::atomic<juce::uint64>& value, juce::uint64 amount) noexcept
+    {
+        value.store (value.load (std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    void clear() noexcept;
+
+    AtomicStage m_stages[numStages];
+    std::atomic<juce::uint64> m_numSamples { 0 }, m_numOverruns { 0 };
+    std::atomic<float> m_lastLoad { 0.0f }, m_maxLoad { 0.0f };
+    std::atomic<bool> m_resetRequested { false };
+
+    // Audio thread only
+    juce::uint64 m_blockTicks[numStages] = {};
+    juce::uint64 m_blockStart = 0;
+    double m_deadlineTicksPerSample = 0.0;
+    double m_ticksPerSecond = 1.0;
+    double m_sampleRate = 44100.0;
+
+    JUCE_DECLARE_NON_COPYABLE (PerformanceMonitor)
+};
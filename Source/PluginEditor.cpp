@@ -13,6 +13,7 @@
 FractureAudioProcessorEditor::FractureAudioProcessorEditor (FractureAudioProcessor& p)
     : AudioProcessorEditor (&p), audioProcessor (p)
 {
+    setOpaque (true);
     setSize (600, 400);
     
     m_dryWetKnobListener = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.apvts, "DRYWET", m_dryWetKnob);
@@ -22,8 +23,10 @@ FractureAudioProcessorEditor::FractureAudioProcessorEditor (FractureAudioProcess
 	m_shakeKnobListener = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(audioProcessor.apvts, "SHAKE", m_shakeKnob);
 
     initializeKnobs();
-
-	startTimer(60);
+    initializeTimings();
+    initializePresets();
+    initializeImpulse();
+    updateVisuals();
 }
 
 void FractureAudioProcessorEditor::initializeKnobs()
@@ -84,6 +87,165 @@ void FractureAudioProcessorEditor::initializeKnobs()
 	addAndMakeVisible(m_shakeLabel);
 }
 
+void FractureAudioProcessorEditor::initializeTimings()
+{
+	m_loadLabel.setBounds(5, 375, 220, 20);
+	m_loadLabel.setFont(juce::FontOptions(12.0f));
+	m_loadLabel.setTooltip("DSP time as a share of the real-time budget, measured inside processBlock");
+	addAndMakeVisible(m_loadLabel);
+
+	m_echoLabel.setBounds(460, 300, 135, 20);
+	m_echoLabel.setFont(juce::FontOptions(12.0f));
+	addAndMakeVisible(m_echoLabel);
+
+	m_dumpTimingsButton.setBounds(230, 375, 100, 20);
+	m_dumpTimingsButton.onClick = [this]
+	{
+		auto file = juce::File::getSpecialLocation(juce::File::userDesktopDirectory)
+			.getNonexistentChildFile("Fracture timings " + juce::Time::getCurrentTime().formatted("%Y-%m-%d %H-%M-%S"), ".csv");
+
+		if (audioProcessor.getPerformanceMonitor().writeCsv(file))
+			file.revealToUser();
+	};
+	addAndMakeVisible(m_dumpTimingsButton);
+
+	updateLoadLabel();
+	updateEchoLabel();
+}
+
+void FractureAudioProcessorEditor::initializePresets()
+{
+	m_presetSearch.setBounds(460, 350, 135, 20);
+	m_presetSearch.setTextToShowWhenEmpty("Search, or #tag", Colours::grey);
+	m_presetSearch.onTextChange = [this] { updatePresetList(); };
+	addAndMakeVisible(m_presetSearch);
+
+	// Loading goes through the host's state recall, so presets can be auditioned while playing
+	m_presetBox.setBounds(460, 375, 135, 20);
+	m_presetBox.setTextWhenNothingSelected("Presets");
+	m_presetBox.setTextWhenNoChoicesAvailable("No presets");
+	m_presetBox.onChange = [this]
+	{
+		if (m_presetBox.getSelectedId() > 0)
+			audioProcessor.loadPreset(m_presetBox.getSelectedId() - 1);
+	};
+	addAndMakeVisible(m_presetBox);
+
+	// A library rebuilt since the last editor was open is picked up now, and later ones on the refresh timer
+	audioProcessor.refreshPresetLibrary();
+	m_lastPresetRefreshMs = juce::Time::getMillisecondCounterHiRes();
+	updatePresetList();
+}
+
+void FractureAudioProcessorEditor::updatePresetList()
+{
+	auto& library = audioProcessor.getPresetLibrary();
+	auto text = m_presetSearch.getText().trim();
+
+	auto matches = text.startsWithChar('#') ? library.getPresetsWithTag(text.substring(1))
+											: library.search(text, maxListedPresets);
+
+	m_presetBox.clear(dontSendNotification);
+
+	for (int i = 0; i < juce::jmin(matches.size(), maxListedPresets); ++i)
+		m_presetBox.addItem(library.getName(matches[i]), matches[i] + 1);
+}
+
+void FractureAudioProcessorEditor::initializeImpulse()
+{
+	m_impulseButton.setBounds(460, 325, 135, 20);
+	m_impulseButton.setTooltip("Impulse response the Smear convolves the repeats with");
+	m_impulseButton.onClick = [this]
+	{
+		PopupMenu menu;
+		menu.addItem(1, "Load impulse response...");
+		menu.addItem(2, "Generated smear", true, audioProcessor.getImpulseFile() == juce::File());
+
+		menu.showMenuAsync(PopupMenu::Options().withTargetComponent(&m_impulseButton), [this](int result)
+		{
+			if (result == 2)
+			{
+				audioProcessor.clearImpulseResponse();
+				updateImpulseButton();
+			}
+			else if (result == 1)
+			{
+				m_impulseChooser = std::make_unique<juce::FileChooser>("Impulse response", audioProcessor.getImpulseFile(), "*.wav;*.aif;*.aiff;*.flac");
+				m_impulseChooser->launchAsync(FileBrowserComponent::openMode | FileBrowserComponent::canSelectFiles, [this](const FileChooser& chooser)
+				{
+					auto file = chooser.getResult();
+
+					if (file != juce::File())
+					{
+						auto loaded = audioProcessor.loadImpulseResponse(file);
+
+						if (loaded.failed())
+							AlertWindow::showMessageBoxAsync(MessageBoxIconType::WarningIcon, "Smear", loaded.getErrorMessage());
+					}
+
+					updateImpulseButton();
+				});
+			}
+		});
+	};
+	addAndMakeVisible(m_impulseButton);
+
+	updateImpulseButton();
+}
+
+void FractureAudioProcessorEditor::updateImpulseButton()
+{
+	auto file = audioProcessor.getImpulseFile();
+	m_impulseButton.setButtonText(file == juce::File() ? "Smear: generated" : "Smear: " + file.getFileNameWithoutExtension());
+}
+
+void FractureAudioProcessorEditor::updateLoadLabel()
+{
+	auto statistics = audioProcessor.getPerformanceMonitor().getStatistics();
+	auto sampleRate = juce::jmax(1.0, audioProcessor.getSampleRate());
+
+	m_loadLabel.setText("DSP " + juce::String(100.0 * statistics.getAverageLoad(sampleRate), 2) + "% avg, "
+						+ juce::String(100.0f * statistics.maxLoad, 1) + "% max, "
+						+ juce::String((juce::int64) statistics.numOverruns) + " overruns",
+						dontSendNotification);
+}
+
+void FractureAudioProcessorEditor::updateEchoLabel()
+{
+	auto mode = static_cast<DelayMode>(juce::roundToInt(audioProcessor.apvts.getRawParameterValue("MODE")->load()));
+	// A recirculating line's repeats come out of one read head together, so its echoes are a history of that output
+	if (mode == DelayMode::multiTap)
+	{
+		m_echoLabel.setText("Echoes: the first five taps", dontSendNotification);
+		m_echoLabel.setTooltip("Each echo is the level its tap reads from the line");
+	}
+	else if (mode == DelayMode::single)
+	{
+		m_echoLabel.setText("Echoes: line output", dontSendNotification);
+		m_echoLabel.setTooltip("Each echo is the level that came out of the line one DELAYTIME before the one in front of it");
+	}
+	else
+	{
+		m_echoLabel.setText("Echoes: not drawn in Diffuse", dontSendNotification);
+		m_echoLabel.setTooltip({});
+	}
+}
+
+void FractureAudioProcessorEditor::updateTelemetry(double elapsedMs)
+{
+	// A failed read keeps the previous frame; the next one will get a newer one
+	audioProcessor.getTelemetryBus().read(m_telemetry);
+
+	// Levels fall by 30% every 60 ms, and snap to silence below -60 dB so the visuals come to rest
+	auto fallback = static_cast<float>(std::pow(0.7, elapsedMs / 60.0));
+
+	for (int i = 0; i < TelemetryFrame::numEchoes; ++i)
+	{
+		auto level = juce::jmax(m_telemetry.echoLevels[i], m_echoDisplayLevels[i] * fallback);
+		m_echoDisplayLevels[i] = level < 0.001f ? 0.0f : level;
+	}
+}
+
 FractureAudioProcessorEditor::~FractureAudioProcessorEditor()
 {
 }
@@ -91,46 +253,142 @@ FractureAudioProcessorEditor::~FractureAudioProcessorEditor()
 //==============================================================================
 void FractureAudioProcessorEditor::paint (juce::Graphics& g)
 {
-    // (Our component is opaque, so we must completely fill the background with a solid colour)
-    g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
+	auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+	if (scale != m_layerScale || m_backgroundLayer.isNull())
+		renderLayers(scale);
+
+	auto bounds = getLocalBounds().toFloat();
+	auto clip = g.getClipBounds();
+
+	// (Our component is opaque, so we must completely fill the background with a solid colour)
+	g.drawImage(m_backgroundLayer, bounds);
+
+	if (clip.intersects(m_linesArea))
+	{
+		g.setOpacity(m_linesAlpha);
+		g.drawImage(m_linesLayer, bounds);
+	}
+
+	for (auto& object : objects)
+	{
+		auto area = object.getSpriteBounds();
+
+		if (object.getAlpha() > 0.0f && clip.intersects(area.getSmallestIntegerContainer()))
+		{
+			g.setOpacity(object.getAlpha());
+			g.drawImage(m_objectSprite, area);
+		}
+	}
+}
+
+void FractureAudioProcessorEditor::renderLayers(float scale)
+{
+	m_layerScale = scale;
+
+	auto width = juce::roundToInt(getWidth() * scale), height = juce::roundToInt(getHeight() * scale);
+
+	m_backgroundLayer = juce::Image(juce::Image::RGB, juce::jmax(1, width), juce::jmax(1, height), false);
+	{
+		juce::Graphics g(m_backgroundLayer);
+		g.fillAll(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId));
+	}
+
+	m_linesLayer = juce::Image(juce::Image::ARGB, juce::jmax(1, width), juce::jmax(1, height), true);
+	{
+		juce::Graphics g(m_linesLayer);
+		g.addTransform(juce::AffineTransform::scale(scale));
+		g.setColour(juce::Colours::white);
+		g.drawLine(400, 30, 400, 380, 2);
+		g.drawLine(350, 30, 390, 380, 2);
+		g.drawLine(450, 30, 410, 380, 2);
+	}
+
+	m_objectSprite = objects[0].createSprite(scale);
+}
+
+void FractureAudioProcessorEditor::onVBlank()
+{
+	auto now = juce::Time::getMillisecondCounterHiRes();
+
+	// The statistics change slowly; refreshing them about twice a second keeps the text readable
+	if (now - m_lastLoadUpdateMs >= loadUpdateIntervalMs)
+	{
+		m_lastLoadUpdateMs = now;
+		updateLoadLabel();
+		updateEchoLabel();
+	}
 
-    g.setColour (juce::Colours::white);
-    g.setFont (juce::FontOptions (15.0f));
+	// Looking for a new library version lists its directory, so it is done rarely rather than per keystroke
+	if (now - m_lastPresetRefreshMs >= presetRefreshIntervalMs)
+	{
+		m_lastPresetRefreshMs = now;
 
-	g.setColour(juce::Colours::white);
-    g.drawLine(400, 30, 400, 380, 2);
-    g.drawLine(350, 30, 390, 380, 2);
-    g.drawLine(450, 30, 410, 380, 2);
+		if (audioProcessor.refreshPresetLibrary())
+			updatePresetList();
+	}
 
+	if (now - m_lastFrameMs < frameIntervalMs)
+		return;
+
+	updateTelemetry(juce::jmin(now - m_lastFrameMs, 250.0));
+	m_lastFrameMs = now;
+	updateVisuals();
+}
+
+void FractureAudioProcessorEditor::updateVisuals()
+{
 	float currentDelayTime = m_delayTimeKnob.getValue();
-	float currentFeedback = m_feedbackKnob.getValue();
 	float currentStereo = m_stereoKnob.getValue();
 	float currentShake = m_shakeKnob.getValue();
-    
-    for (int i = 0; i < 6; i++)
-    {
-		float currentShakeX = randomShake.nextFloat() * currentShake;
-        float currentShakeY = randomShake.nextFloat() * currentShake;
+
+	// The lines glow with the output
+	auto outputDb = juce::Decibels::gainToDecibels(m_telemetry.outputPeak, -60.0f);
+	auto linesAlpha = juce::jlimit(0.3f, 1.0f, std::round(juce::jmap(outputDb, -60.0f, 0.0f, 0.3f, 1.0f) * 64.0f) / 64.0f);
+
+	if (linesAlpha != m_linesAlpha)
+	{
+		m_linesAlpha = linesAlpha;
+		repaint(m_linesArea);
+	}
+
+	for (int i = 0; i < TelemetryFrame::numEchoes; i++)
+	{
+		// Each object is one repeat: it shows as loud as that repeat is heard now (-60 dB
+		// and below is invisible) and shakes with its level. Alpha is kept to what 8 bits can show.
+		auto levelDb = juce::Decibels::gainToDecibels(m_echoDisplayLevels[i], -60.0f);
+		auto brightness = juce::jlimit(0.0f, 1.0f, juce::jmap(levelDb, -60.0f, 0.0f, 0.0f, 1.0f));
+		brightness = std::round(brightness * 255.0f) / 255.0f;
+
+		float currentShakeX = randomShake.nextFloat() * currentShake * brightness;
+		float currentShakeY = randomShake.nextFloat() * currentShake * brightness;
 		float side = (i % 2 == 0) ? 1 : -1;
 
-        objects[i].setPosition(350 + currentShakeX + (side * ((currentStereo / 80) * (5 * i) * 0.4)),
-                               330 + currentShakeY - (i * (60 * currentDelayTime / 500.0)));
-        
-        //float feedbackGradiant = (i * 0.1 / juce::jmap<float>(currentFeedback, 0.0, 1.0, 0.1, 1.0));
-        objects[i].setAlpha(pow(currentFeedback,i));
+		juce::Point<float> position(350 + currentShakeX + (side * ((currentStereo / 80) * (5 * i) * 0.4)),
+									330 + currentShakeY - (i * (60 * currentDelayTime / 500.0)));
+
+		auto& object = objects[i];
 
-        objects[i].draw(g, 100);
-    }
+		if (position == object.getPosition() && brightness == object.getAlpha())
+			continue;
 
+		// Only what the object covered before and covers now needs drawing again
+		auto previousArea = object.getSpriteBounds();
+		object.setPosition(position.x, position.y);
+		object.setAlpha(brightness);
+		repaint(previousArea.getUnion(object.getSpriteBounds()).getSmallestIntegerContainer());
+	}
 }
 
 void FractureAudioProcessorEditor::resized()
 {
     // This is generally where you'll want to lay out the positions of any
     // subcomponents in your editor..
+    m_layerScale = 0.0f;
 }
 
-void FractureAudioProcessorEditor::timerCallback()
+void FractureAudioProcessorEditor::lookAndFeelChanged()
 {
+	m_layerScale = 0.0f;
 	repaint();
 }
\ No newline at end of file
@@ -17,17 +17,16 @@ using namespace juce;
 //==============================================================================
 /**
 */
-class FractureAudioProcessorEditor : public juce::AudioProcessorEditor, public juce::Timer
+class FractureAudioProcessorEditor : public juce::AudioProcessorEditor
 {
 public:
     FractureAudioProcessorEditor (FractureAudioProcessor&);
     ~FractureAudioProcessorEditor() override;
 
-    void timerCallback() override;
-
     //==============================================================================
     void paint (juce::Graphics&) override;
     void resized() override;
+    void lookAndFeelChanged() override;
 
 private:
     // This reference is provided as a quick way for your editor to
@@ -46,6 +45,19 @@ private:
 	Label m_stereoLabel;
 	Label m_shakeLabel;
 
+	Label m_loadLabel;
+	Label m_echoLabel;
+	TextButton m_dumpTimingsButton{ "Dump timings" };
+
+	// Presets from the library: the search narrows the list, and picking one loads it
+	static constexpr int maxListedPresets = 200;
+	TextEditor m_presetSearch;
+	ComboBox m_presetBox;
+
+	// The smear's impulse response: a file, or the generated one
+	TextButton m_impulseButton;
+	std::unique_ptr<juce::FileChooser> m_impulseChooser;
+
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> m_dryWetKnobListener;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> m_delayTimeKnobListener;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> m_feedbackKnobListener;
@@ -53,11 +65,49 @@ private:
 	std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> m_shakeKnobListener;
 
     void initializeKnobs();
+    void initializeTimings();
+    void initializePresets();
+    void initializeImpulse();
+    void updateImpulseButton();
+    void updatePresetList();
+    void updateLoadLabel();
+    void updateEchoLabel();
+    void updateTelemetry(double elapsedMs);
+
+    //---------------------------------------------------
+    //             Frame pacing
+    // Frames are driven by the display's vertical blank, at most one every frameIntervalMs.
+    // A frame repaints only the objects and lines that changed, and nothing when the
+    // visuals are still, so idle editors cost no drawing at all.
+    static constexpr double frameIntervalMs = 33.0;
+    static constexpr double loadUpdateIntervalMs = 500.0;
+    static constexpr double presetRefreshIntervalMs = 2000.0;   // looks for a rebuilt preset library
+
+    void onVBlank();
+    void updateVisuals();
+    void renderLayers(float scale);
+
+    double m_lastFrameMs = 0.0;
+    double m_lastLoadUpdateMs = 0.0;
+    double m_lastPresetRefreshMs = 0.0;
 
     //---------------------------------------------------
     //             Visuals
-    SpaceObject objects[6];
+    SpaceObject objects[TelemetryFrame::numEchoes];
     juce::Random randomShake;
 
+    // Latest frame from the audio thread, and the levels drawn from it, which fall back slowly
+    TelemetryFrame m_telemetry;
+    float m_echoDisplayLevels[TelemetryFrame::numEchoes] = {};
+
+    // Static parts drawn once per scale factor: the background, and the guide lines on their
+    // own layer so they can glow through opacity alone. One sprite serves all the objects.
+    juce::Image m_backgroundLayer, m_linesLayer, m_objectSprite;
+    float m_layerScale = 0.0f;
+    float m_linesAlpha = 0.3f;
+    const juce::Rectangle<int> m_linesArea { 348, 28, 104, 354 };
+
+    juce::VBlankAttachment m_vBlankAttachment { this, [this] { onVBlank(); } };
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FractureAudioProcessorEditor)
 };
@@ -8,6 +8,7 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "DelayKernels.h"
 
 //==============================================================================
 FractureAudioProcessor::FractureAudioProcessor()
@@ -22,6 +23,8 @@ FractureAudioProcessor::FractureAudioProcessor()
 					   ), apvts(*this, nullptr, juce::Identifier("PARAMETERS"), createParameters())
 #endif
 {
+    // Only maps the file, so it costs the same for every instance however big the library is
+    m_presetLibrary.open(PresetLibrary::getDefaultFile());
 }
 
 FractureAudioProcessor::~FractureAudioProcessor()
@@ -63,7 +66,45 @@ bool FractureAudioProcessor::isMidiEffect() const
 
 double FractureAudioProcessor::getTailLengthSeconds() const
 {
-	return 0.0;
+    auto delayMs = apvts.getRawParameterValue("DELAYTIME")->load();
+
+    // The smear rings on for its impulse response after the last repeat
+    auto smearSeconds = apvts.getRawParameterValue("SMEAR")->load() > 0.0f ? m_smear.getImpulseSeconds() : 0.0;
+
+    // Taps don't recirculate, so the tail ends with the last one: TAPS times DELAYTIME back
+    // or as far as the line reaches, whichever is nearer (see MultiTapEngine::setEchoLayout),
+    // or the longest TAPnTIME in use
+    if (static_cast<DelayMode>(juce::roundToInt(apvts.getRawParameterValue("MODE")->load())) == DelayMode::multiTap)
+    {
+        auto numTaps = juce::roundToInt(apvts.getRawParameterValue("TAPS")->load());
+        auto maxDelayMs = apvts.getParameterRange("DELAYTIME").end + apvts.getParameterRange("STEREO").end;
+        auto lastTapMs = juce::jmin(static_cast<float>(numTaps) * delayMs, maxDelayMs);
+
+        if (static_cast<TapLayout>(juce::roundToInt(apvts.getRawParameterValue("TAPLAYOUT")->load())) == TapLayout::manual)
+        {
+            lastTapMs = 0.0f;
+
+            for (int tap = 1; tap <= numTaps; ++tap)
+                lastTapMs = juce::jmax(lastTapMs, apvts.getRawParameterValue("TAP" + juce::String(tap) + "TIME")->load());
+        }
+
+        return lastTapMs / 1000.0 + smearSeconds;
+    }
+
+    // Every round trip through the line scales the repeats by FEEDBACK, so count
+    // the trips it takes to fall below the idle threshold. The diffuse mode's lines
+    // are no longer than the single line and lose as much per trip, so it rings no longer
+    auto period = (delayMs + apvts.getRawParameterValue("STEREO")->load()) / 1000.0;
+    auto feedback = static_cast<double>(apvts.getRawParameterValue("FEEDBACK")->load());
+
+    if (feedback >= 0.999)
+        return std::numeric_limits<double>::infinity();
+
+    if (feedback <= 0.0)
+        return period + smearSeconds;
+
+    auto numRepeats = std::log(static_cast<double>(IdleDetector::silenceThreshold)) / std::log(feedback);
+    return period * (1.0 + numRepeats) + smearSeconds;
 }
 
 int FractureAudioProcessor::getNumPrograms()
@@ -96,16 +137,100 @@ void FractureAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlo
 	m_sampleRate = sampleRate;
 	m_samplesPerBlock = samplesPerBlock;
     
-    auto delayBufferSize = static_cast<int>(sampleRate * 2.0); // 2 seconds delay
-    m_delayBuffer.setSize(getTotalNumOutputChannels(), static_cast<int>(delayBufferSize));
+    m_speakerLayout.setChannelSet(getChannelLayoutOfBus(false, 0));
+
+    // A repeat reaches back the longest DELAYTIME plus the longest STEREO offset, and the
+    // multi-tap taps are kept within the same reach. The line holds that, and one sub-block
+    // and the interpolation taps past it
+    auto maxDelayMs = apvts.getParameterRange("DELAYTIME").end + apvts.getParameterRange("STEREO").end;
+    auto maxDelaySamples = maxDelayMs * sampleRate / 1000.0;
+    auto delayBufferSize = static_cast<int>(std::ceil(maxDelaySamples)) + subBlockSize + 8;
+
+    // Everything downstream sees at most one sub-block, whatever the host's block size
+    auto numChannels = getTotalNumOutputChannels();
+    auto delayLayout = numChannels > 2 ? DelayLayout::laned
+                                       : numChannels == 2 && m_requestedDelayLayout == DelayLayout::interleaved ? DelayLayout::interleaved
+                                                                                                                : DelayLayout::planar;
+    m_doublePrecision = isUsingDoublePrecision();
+    m_halfPrecision = m_halfPrecisionRequested && ! m_doublePrecision;
+
+    // Only the line the active precision and storage format use holds any memory
+    if (m_doublePrecision)
+        m_doubleDelayBuffer.setSize(numChannels, delayBufferSize, subBlockSize, delayLayout);
+    else
+        m_doubleDelayBuffer.release();
 
-	m_filter.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, 1000.0f);
+    if (m_halfPrecision)
+        m_halfDelayBuffer.setSize(numChannels, delayBufferSize, subBlockSize, delayLayout);
+    else
+        m_halfDelayBuffer.release();
+
+    if (! m_doublePrecision && ! m_halfPrecision)
+        m_delayBuffer.setSize(numChannels, delayBufferSize, subBlockSize, delayLayout);
+    else
+        m_delayBuffer.release();
+
+    m_kernels = KernelDispatch::getTable(m_requestedKernelIsa);
+
+    if (m_kernels == nullptr)
+        m_kernels = KernelDispatch::getTable(KernelDispatch::Isa::automatic);
+
+    m_writeScratch.setSize(1, DelayKernels::channelLanes * subBlockSize); // room for a span of frames
+    m_multiTap.prepare(subBlockSize, static_cast<float>(maxDelaySamples), *m_kernels);
+    m_diffusion.prepare(m_requestedDiffusionLines, numChannels, maxDelaySamples, subBlockSize, m_doublePrecision, *m_kernels);
+    m_stateRecall.prepare(! isNonRealtime()); // before the ramps start, so a pending recall starts with them
+    m_parameters.prepare(sampleRate, subBlockSize, m_speakerLayout);
+    m_idleDetector.reset();
+    m_performanceMonitor.prepare(sampleRate);
+    m_telemetry.prepare(sampleRate, apvts.getParameterRange("DELAYTIME").end);
+    m_coefficientWorker.prepare(sampleRate, ! isNonRealtime());
+    m_smear.prepare(sampleRate, numChannels, subBlockSize, ! isNonRealtime(), *m_kernels);
+
+    auto snapshot = m_parameters.getSnapshot();
+    prepareCore(m_floatCore, delayLayout);
+    prepareCore(m_doubleCore, delayLayout);
+
+    auto filtered = m_doublePrecision ? m_doubleCore.feedbackFilter.isActive() : m_floatCore.feedbackFilter.isActive();
+    selectKernel(snapshot.mode, snapshot.interpolation, filtered);
+}
+
+template <typename SampleType>
+void FractureAudioProcessor::prepareCore(ProcessingCore<SampleType>& core, DelayLayout layout)
+{
+    core.feedbackFilter.prepare(subBlockSize);
+    core.feedbackFilter.setDesign(m_coefficientWorker.acquire().getTone<SampleType>());
+    m_coefficientWorker.release();
+    core.readHeads.clear();
+
+    for (int channel = 0; channel < getTotalNumOutputChannels(); ++channel)
+        core.readHeads.add(new FractionalReadHead<SampleType>())->prepare(subBlockSize, *m_kernels);
+
+    // A laned line is read a group of channels at a time instead
+    auto numChannels = getTotalNumOutputChannels();
+    auto numGroups = layout == DelayLayout::laned ? (numChannels + DelayKernels::channelLanes - 1) / DelayKernels::channelLanes : 0;
+    core.lanedReadHeads.clear();
+
+    for (int group = 0; group < numGroups; ++group)
+        core.lanedReadHeads.add(new LanedReadHead<SampleType>())->prepare(subBlockSize, *m_kernels);
+
+    core.laneChannels.setSize(numGroups > 0 ? numChannels : 0, subBlockSize);
+    core.laneFrames.setSize(numGroups > 0 ? numGroups + 1 : 0, DelayKernels::channelLanes * subBlockSize);
 }
 
 void FractureAudioProcessor::releaseResources()
 {
 	// When playback stops, you can use this as an opportunity to free up any
 	// spare memory, etc.
+	m_stateRecall.release();
+}
+
+void FractureAudioProcessor::setNonRealtime(bool isNonRealtime) noexcept
+{
+	AudioProcessor::setNonRealtime(isNonRealtime);
+
+	// Hosts can switch to offline rendering and back without preparing again
+	m_coefficientWorker.setRealtime(! isNonRealtime);
+	m_smear.setRealtime(! isNonRealtime);
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -115,12 +240,8 @@ bool FractureAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
 	juce::ignoreUnused (layouts);
 	return true;
   #else
-	// This is the place where you check if the params is supported.
-	// In this template code we only support mono or stereo.
-	// Some plugin hosts, such as certain GarageBand versions, will only
-	// load plugins that support stereo bus layouts.
-	if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-	 && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+	// Mono, stereo, surround up to 7.1.4 and first to third order ambisonics
+	if (! SpeakerLayout::isSupported(layouts.getMainOutputChannelSet()))
 		return false;
 
 	// This checks if the input params matches the output params
@@ -135,6 +256,22 @@ bool FractureAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
 #endif
 
 void FractureAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processSamples(buffer);
+}
+
+void FractureAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processSamples(buffer);
+}
+
+bool FractureAudioProcessor::supportsDoublePrecisionProcessing() const
+{
+    return true;
+}
+
+template <typename SampleType>
+void FractureAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer)
 {
 	juce::ScopedNoDenormals noDenormals;
 	auto totalNumInputChannels  = getTotalNumInputChannels();
@@ -143,140 +280,421 @@ void FractureAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
 	for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
 		buffer.clear (i, 0, buffer.getNumSamples());
 
-    for (int channel = 0; channel < totalNumInputChannels; ++channel)
-    {
+    auto numSamples = buffer.getNumSamples();
+    auto inputPeak = 0.0f;
+
+    if (numSamples == 0)
+        return;
 
-        // Copy input signal to a delay buffer
-        fillBuffer(buffer, channel);
+    m_performanceMonitor.startBlock();
 
-        // Read from the past in the delay buffer, then add back to main buffer
-        readFromBuffer(buffer, m_delayBuffer, channel);
+    for (int channel = 0; channel < totalNumInputChannels; ++channel)
+        inputPeak = juce::jmax(inputPeak, static_cast<float>(buffer.getMagnitude(channel, 0, numSamples)));
 
-        // Copy input signal to a delay buffer
-        feedbackBuffer(buffer, channel);
+    // Asleep, the wet signal is silence, so the (silent) input passes through untouched
+    if (m_idleDetector.isSleeping())
+    {
+        if (IdleDetector::isSilent(inputPeak))
+        {
+            m_stateRecall.beginBlock(m_parameters, m_coefficientWorker, true);
+            m_telemetry.update(inputPeak, inputPeak, m_parameters.getSnapshot(), numSamples);
+            m_performanceMonitor.endBlock(numSamples);
+            return;
+        }
+
+        m_idleDetector.wake();
     }
 
-    updateBufferPositions(buffer, m_delayBuffer);
-}
+    // A preset recall switches the parameters while the wet path is faded out
+    m_stateRecall.beginBlock(m_parameters, m_coefficientWorker, false);
 
-void FractureAudioProcessor::fillBuffer(juce::AudioBuffer<float>& buffer, int channel)
-{
-    auto bufferSize = buffer.getNumSamples();
-    auto delayBufferSize = m_delayBuffer.getNumSamples();
-    auto* wet = apvts.getRawParameterValue("DRYWET");
+    auto& core = getCore<SampleType>();
+    SmoothedParameters parameters;
 
-    //buffer.applyGain(0, bufferSize, 1.0f - (wet->load() / 100.0f)); TODO- check this crap
+    // Offline there are no worker threads, so a parameter change is designed for right here
+    m_coefficientWorker.update();
+    m_smear.update();
 
-    // Check to see if main buffer copies to delay buffer without needing to wrap..
-    if (delayBufferSize > bufferSize + m_writePosition)
+    // The set is held for this block only; release() below lets the worker free older ones
+    auto& coefficients = m_coefficientWorker.acquire();
+    core.feedbackFilter.setDesign(coefficients.getTone<SampleType>());
+
+    // Host blocks of any size run as fixed sub-blocks: the working set stays in cache,
+    // and parameters are picked up at every sub-block boundary
+    for (int start = 0; start < numSamples; start += subBlockSize)
     {
-        // if yes
-               // copy main buffer contents to delay buffer
-        m_delayBuffer.copyFrom(channel, m_writePosition, buffer.getWritePointer(channel), bufferSize);
+        auto subBlockSamples = juce::jmin(subBlockSize, numSamples - start);
+        juce::AudioBuffer<SampleType> subBlock(buffer.getArrayOfWritePointers(), totalNumInputChannels, start, subBlockSamples);
+
+        {
+            PerformanceMonitor::ScopedStage stage(m_performanceMonitor, PerformanceMonitor::parameterStage);
+            parameters = m_parameters.process(subBlockSamples);
+        }
+
+        // Diffuse doesn't write the line, and the other modes don't run the network, so
+        // whichever the new mode uses holds nothing but old repeats; the switch happened
+        // with the wet faded out
+        if (parameters.modeChanged)
+        {
+            m_delayBuffer.clear();
+            m_halfDelayBuffer.clear();
+            m_doubleDelayBuffer.clear();
+            m_diffusion.clear();
+        }
+
+        // Only a change of mode, interpolator or filter state swaps the specialisation
+        if (parameters.mode != m_kernelMode || parameters.interpolation != m_kernelInterpolation
+            || core.feedbackFilter.isActive() != m_kernelFiltered)
+            selectKernel(parameters.mode, parameters.interpolation, core.feedbackFilter.isActive());
+
+        {
+            PerformanceMonitor::ScopedStage stage(m_performanceMonitor, PerformanceMonitor::smearStage);
+            m_smear.capture(subBlock, parameters.smear);
+        }
+
+        (this->*core.kernel)(subBlock, parameters);
+
+        // The smear works on whatever the kernel added, so it is the same for every mode
+        {
+            PerformanceMonitor::ScopedStage stage(m_performanceMonitor, PerformanceMonitor::smearStage);
+            m_smear.process(subBlock, parameters.smear);
+        }
     }
-    // if no
-    else
-    {
-        // Determine how much space is left at the end of the delay buffer
-        auto numSamplesToEnd = delayBufferSize - m_writePosition;
 
-        // Copy that amount of contents to the end...
-        m_delayBuffer.copyFrom(channel, m_writePosition, buffer.getWritePointer(channel), numSamplesToEnd);
+    // What went into the line is at most the input plus the output it fed back
+    auto outputPeak = 0.0f;
 
-        // Calculate how much contents is remaining to copy
-        auto numSamplesAtStart = bufferSize - numSamplesToEnd;
-
-        // Copy remaining amount to beginning of delay buffer
-        m_delayBuffer.copyFrom(channel, 0, buffer.getWritePointer(channel, numSamplesToEnd-1), numSamplesAtStart);
-    }
+    for (int channel = 0; channel < totalNumInputChannels; ++channel)
+        outputPeak = juce::jmax(outputPeak, static_cast<float>(buffer.getMagnitude(channel, 0, numSamples)));
 
-    /*
-       DBG ("Delay Buffer Size: " << delayBufferSize);
-       DBG ("Buffer Size: " << bufferSize);
-       DBG ("Write Position: " << m_writePosition);
-       */
-}
+    auto lastSample = parameters.numSamples - 1;
+    auto lastDelay = parameters.delaySamples[lastSample] + parameters.stereoSamples[lastSample]; // no speaker adds more than STEREO
+    auto longestDelay = parameters.mode == DelayMode::multiTap ? m_multiTap.getLongestDelay() : lastDelay;
+    auto capacity = m_doublePrecision ? m_doubleDelayBuffer.getCapacity()
+                                      : m_halfPrecision ? m_halfDelayBuffer.getCapacity() : m_delayBuffer.getCapacity();
+    auto reach = juce::jmin(capacity, static_cast<int>(longestDelay) + 8); // plus the interpolation taps
 
-void FractureAudioProcessor::feedbackBuffer(juce::AudioBuffer<float>& buffer, int channel)
-{
-    auto bufferSize = buffer.getNumSamples();
-    auto delayBufferSize = m_delayBuffer.getNumSamples();
-    // feedback
-    auto fb = apvts.getRawParameterValue("FEEDBACK")->load();
+    if (parameters.smear[lastSample] > 0.0f)
+        reach += m_smear.getImpulseLength();
 
-    // Check to see if main buffer copies to delay buffer without needing to wrap...
-    if (delayBufferSize >= bufferSize + m_writePosition)
+    // Clearing on the way to sleep means a longer delay set while asleep can't reach old audio
+    if (m_idleDetector.update(inputPeak + outputPeak, numSamples, reach))
     {
-        // copy main buffer contents to delay buffer
-        m_delayBuffer.addFromWithRamp(channel, m_writePosition, buffer.getWritePointer(channel), bufferSize, fb, fb);
+        m_delayBuffer.clear();
+        m_halfDelayBuffer.clear();
+        m_doubleDelayBuffer.clear();
+        m_diffusion.clear();
+        m_smear.reset();
     }
-    // if no
-    else
-    {
-        // Determine how much space is left at the end of the delay buffer
-        auto numSamplesToEnd = delayBufferSize - m_writePosition;
 
-        // Copy that amount of contents to the end...
-        m_delayBuffer.addFromWithRamp(channel, m_writePosition, buffer.getWritePointer(channel), numSamplesToEnd, fb, fb);
+    m_telemetry.update(inputPeak, outputPeak, m_parameters.getSnapshot(), numSamples);
+    m_coefficientWorker.release();
 
-        // Calculate how much contents is remaining to copy
-        auto numSamplesAtStart = bufferSize - numSamplesToEnd;
+    m_performanceMonitor.endBlock(numSamples);
+}
 
-        // Copy remaining amount to beginning of delay buffer
-        m_delayBuffer.addFromWithRamp(channel, 0, buffer.getWritePointer(channel, numSamplesToEnd), numSamplesAtStart, fb, fb);
-    }
+void FractureAudioProcessor::selectKernel(DelayMode mode, Interpolation interpolation, bool filtered) noexcept
+{
+    m_kernelMode = mode;
+    m_kernelInterpolation = interpolation;
+    m_kernelFiltered = filtered;
+
+    if (m_doublePrecision)
+        m_doubleCore.kernel = getKernel<double, double>(mode, interpolation, filtered);
+    else if (m_halfPrecision)
+        m_floatCore.kernel = getKernel<float, HalfFloat::Bits>(mode, interpolation, filtered);
+    else
+        m_floatCore.kernel = getKernel<float, float>(mode, interpolation, filtered);
 }
 
-void FractureAudioProcessor::readFromBuffer(juce::AudioBuffer<float>& buffer, juce::AudioBuffer<float>& m_delayBuffer, int channel)
+template <typename SampleType, typename StorageType>
+FractureAudioProcessor::SubBlockKernel<SampleType> FractureAudioProcessor::getKernel(DelayMode mode, Interpolation interpolation,
+                                                                                     bool filtered) noexcept
 {
-    auto bufferSize = buffer.getNumSamples();
-    auto delayBufferSize = m_delayBuffer.getNumSamples();
+    if (mode == DelayMode::multiTap)
+        return &FractureAudioProcessor::processMultiTap<SampleType, StorageType>;
 
-    auto percent = apvts.getRawParameterValue("DRYWET")->load();
-    auto g = juce::jmap(percent, 0.f, 100.f, 0.f, 1.f);
-    auto dryGain = 1.f - g;
+    // The network keeps its own lines in the processing precision, whatever the storage format
+    if (mode == DelayMode::diffuse)
+        return &FractureAudioProcessor::processDiffuse<SampleType>;
 
-    auto stereoDiff = apvts.getRawParameterValue("STEREO")->load();
-    auto delayTimeLeft = apvts.getRawParameterValue("DELAYTIME")->load();
-    auto delayTimeRight = delayTimeLeft + stereoDiff;
+    // Mono and stereo get their channel loops unrolled; wider layouts run in channel lanes
+    auto numChannels = getTotalNumInputChannels();
+    auto layout = getDelayBuffer<StorageType>().getLayout();
 
-    auto delayTime = channel == 0 ? delayTimeLeft : delayTimeRight;
+    if (layout == DelayLayout::laned)
+        return getDelayKernel<SampleType, StorageType, 0, DelayLayout::laned>(interpolation, filtered);
 
-    // m_writePosition = "Where is pur audio currently?"
-    // readPosition = m_writePosition - sampleRate -> 1 second in the past (samplerate amount of audio)
-    // 1 second of audio from in the past
-    auto readPosition = std::round(m_writePosition - (getSampleRate() * delayTime / 1000.0f));
+    if (numChannels == 2 && layout == DelayLayout::interleaved)
+        return getDelayKernel<SampleType, StorageType, 2, DelayLayout::interleaved>(interpolation, filtered);
 
-    if (readPosition < 0)
-        readPosition += delayBufferSize;
+    if (numChannels == 2)
+        return getDelayKernel<SampleType, StorageType, 2, DelayLayout::planar>(interpolation, filtered);
 
-    //buffer.applyGainRamp(0, bufferSize, dryGain, dryGain); TODO- same as other TODO
+    if (numChannels == 1)
+        return getDelayKernel<SampleType, StorageType, 1, DelayLayout::planar>(interpolation, filtered);
 
-    //    auto g = 0.7f; // volume delay
+    return getDelayKernel<SampleType, StorageType, 0, DelayLayout::planar>(interpolation, filtered);
+}
 
-    if (readPosition + bufferSize < delayBufferSize)
+template <typename SampleType, typename StorageType, int fixedChannels, DelayLayout layout>
+FractureAudioProcessor::SubBlockKernel<SampleType> FractureAudioProcessor::getDelayKernel(Interpolation interpolation, bool filtered) noexcept
+{
+    switch (interpolation)
     {
-        buffer.addFromWithRamp(channel, 0, m_delayBuffer.getReadPointer(channel, readPosition), bufferSize, g, g);
+        case Interpolation::lagrange3:
+            return filtered ? &FractureAudioProcessor::processDelay<SampleType, StorageType, fixedChannels, layout, Interpolation::lagrange3, true>
+                            : &FractureAudioProcessor::processDelay<SampleType, StorageType, fixedChannels, layout, Interpolation::lagrange3, false>;
+
+        case Interpolation::hermite:
+            return filtered ? &FractureAudioProcessor::processDelay<SampleType, StorageType, fixedChannels, layout, Interpolation::hermite, true>
+                            : &FractureAudioProcessor::processDelay<SampleType, StorageType, fixedChannels, layout, Interpolation::hermite, false>;
+
+        case Interpolation::linear:
+        default:
+            return filtered ? &FractureAudioProcessor::processDelay<SampleType, StorageType, fixedChannels, layout, Interpolation::linear, true>
+                            : &FractureAudioProcessor::processDelay<SampleType, StorageType, fixedChannels, layout, Interpolation::linear, false>;
     }
-    else
+}
+
+template <typename SampleType, typename StorageType>
+void FractureAudioProcessor::processMultiTap(juce::AudioBuffer<SampleType>& subBlock, const SmoothedParameters& parameters)
+{
+    PerformanceMonitor::ScopedStage stage(m_performanceMonitor, PerformanceMonitor::multiTapStage);
+
+    auto& ring = getDelayBuffer<StorageType>();
+
+    if (parameters.tapLayout == TapLayout::manual)
     {
-        auto numSamplesToEnd = delayBufferSize - readPosition;
-        buffer.addFromWithRamp(channel, 0, m_delayBuffer.getReadPointer(channel, readPosition), numSamplesToEnd, g, g);
+        // Each tap as its own TAPnTIME, TAPnGAIN and TAPnPAN say
+        m_multiTap.setNumTaps(parameters.numTaps);
 
-        auto numSamplesAtStart = bufferSize - numSamplesToEnd;
-        buffer.addFromWithRamp(channel, numSamplesToEnd, m_delayBuffer.getReadPointer(channel, 0), numSamplesAtStart, g, g);
+        for (int tap = 0; tap < m_multiTap.getNumTaps(); ++tap)
+            m_multiTap.setTap(tap, parameters.tapDelaySamples[tap], parameters.tapGains[tap], parameters.tapPans[tap]);
+    }
+    else
+    {
+        // Taps follow the editor's echoes: DELAYTIME apart, fading with FEEDBACK, spread by STEREO
+        auto width = juce::jlimit(0.0f, 1.0f, parameters.stereoSamples[0] / static_cast<float>(0.4 * getSampleRate()));
+        m_multiTap.setEchoLayout(parameters.numTaps, parameters.delaySamples[0], parameters.feedback[0], width);
     }
+
+    for (int channel = 0; channel < subBlock.getNumChannels(); ++channel)
+        m_multiTap.processChannel(ring, channel, m_speakerLayout.getSide(channel), parameters.interpolation,
+                                  subBlock.getWritePointer(channel), parameters.wetGain, subBlock.getNumSamples());
+
+    m_telemetry.addTaps(m_multiTap.getSumMeter(), m_multiTap.getTapPeaks(), m_multiTap.getNumTaps());
+    m_multiTap.resetMeters();
+    ring.advance(subBlock.getNumSamples());
 }
 
-void FractureAudioProcessor::updateBufferPositions(juce::AudioBuffer<float>& buffer, juce::AudioBuffer<float>& m_delayBuffer)
+template <typename SampleType>
+void FractureAudioProcessor::processDiffuse(juce::AudioBuffer<SampleType>& subBlock, const SmoothedParameters& parameters)
 {
-    auto bufferSize = buffer.getNumSamples();
-    auto delayBufferSize = m_delayBuffer.getNumSamples();
+    PerformanceMonitor::ScopedStage stage(m_performanceMonitor, PerformanceMonitor::diffuseStage);
 
-    m_writePosition += bufferSize;
-    m_writePosition %= delayBufferSize; // assure that right position always stays between 0 and delay buffer size
+    // Each speaker's DELAYTIME plus its share of STEREO sizes the lines it feeds and hears
+    m_diffusion.setDelays(parameters.channelDelaySamples, subBlock.getNumChannels());
+    m_diffusion.process(subBlock.getArrayOfWritePointers(), subBlock.getNumChannels(),
+                        parameters.wetGain, parameters.feedback, subBlock.getNumSamples());
 }
 
+template <typename SampleType, typename StorageType, int fixedChannels, DelayLayout layout, Interpolation interpolation, bool filtered>
+void FractureAudioProcessor::processDelay(juce::AudioBuffer<SampleType>& subBlock, const SmoothedParameters& parameters)
+{
+    constexpr auto isDirect = std::is_same_v<StorageType, SampleType>;
+    static_assert(layout != DelayLayout::interleaved || fixedChannels == 2, "only a stereo pair is interleaved");
+
+    constexpr auto lanes = DelayKernels::channelLanes;
+
+    auto& ring = getDelayBuffer<StorageType>();
+    auto& core = getCore<SampleType>();
+    auto& kernels = m_kernels->get<SampleType>();
+    const auto numChannels = fixedChannels > 0 ? fixedChannels : subBlock.getNumChannels();
+    auto bufferSize = subBlock.getNumSamples();
+    const SampleType* delayed[SpeakerLayout::maxChannels] = {};
+    const SampleType* lanedFrames[SpeakerLayout::maxChannels / lanes] = {};
+    const auto numGroups = (numChannels + lanes - 1) / lanes;
+
+    jassert(numChannels == subBlock.getNumChannels() && ring.getLayout() == layout);
+
+    // All channels advance in the same spans so the feedback filter can take them together.
+    // Each read head can only shorten the span: short enough that everything it reads
+    // was written by an earlier span, and that its window never needs to wrap
+    for (int done = 0; done < bufferSize;)
+    {
+        auto writePosition = ring.wrap(ring.getWritePosition() + done);
+        auto numSamples = bufferSize - done;
+
+        auto readStart = PerformanceMonitor::getTicks();
+
+        if constexpr (layout == DelayLayout::laned)
+        {
+            // A whole group of channels is read in one pass, each at its own delay
+            for (int group = 0; group < numGroups; ++group)
+            {
+                auto first = group * lanes;
+                auto count = juce::jmin(lanes, numChannels - first);
+                const float* delays[lanes] = {};
+
+                for (int lane = 0; lane < count; ++lane)
+                    delays[lane] = parameters.getDelays(first + lane) + done;
+
+                numSamples = core.lanedReadHeads[group]->template read<interpolation>(ring, first, count, writePosition, delays, numSamples);
+                lanedFrames[group] = core.lanedReadHeads[group]->getOutput();
+            }
+        }
+        else
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                numSamples = core.readHeads[channel]->template read<interpolation>(ring, channel, writePosition,
+                                                                                   parameters.getDelays(channel) + done, numSamples);
+                delayed[channel] = core.readHeads[channel]->getOutput();
+            }
+        }
+
+        auto filterStart = PerformanceMonitor::getTicks();
+        m_performanceMonitor.addStageTicks(PerformanceMonitor::readStage, filterStart - readStart);
+
+        // Filtering the delayed signal before it is mixed puts the tone stage inside the feedback loop
+        if constexpr (filtered)
+        {
+            // The filter keeps its state per channel, so laned frames go through it planar
+            if constexpr (layout == DelayLayout::laned)
+            {
+                for (int group = 0; group < numGroups; ++group)
+                    kernels.deinterleaveLanes(lanedFrames[group], juce::jmin(lanes, numChannels - group * lanes),
+                                              core.laneChannels.getArrayOfWritePointers() + group * lanes, numSamples);
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                    delayed[channel] = core.laneChannels.getReadPointer(channel);
+            }
+
+            core.feedbackFilter.process(delayed, numChannels, numSamples);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                delayed[channel] = core.feedbackFilter.getOutput(channel);
+
+            if constexpr (layout == DelayLayout::laned)
+            {
+                for (int group = 0; group < numGroups; ++group)
+                {
+                    auto* frames = core.laneFrames.getWritePointer(group);
+                    kernels.interleaveLanes(delayed + group * lanes, juce::jmin(lanes, numChannels - group * lanes), frames, numSamples);
+                    lanedFrames[group] = frames;
+                }
+            }
+
+            m_performanceMonitor.addStageTicks(PerformanceMonitor::filterStage, PerformanceMonitor::getTicks() - filterStart);
+        }
+
+        PerformanceMonitor::ScopedStage stage(m_performanceMonitor, PerformanceMonitor::writeStage);
+
+        // The visualiser meters exactly what goes back into the mix
+        if constexpr (layout == DelayLayout::laned)
+        {
+            for (int group = 0; group < numGroups; ++group)
+                m_telemetry.addDelayedFrames(lanedFrames[group], numSamples, juce::jmin(lanes, numChannels - group * lanes));
+        }
+        else
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+                m_telemetry.addDelayed(delayed[channel], numSamples);
+        }
+
+        // A ring in the processing precision is written in place; a half-precision one
+        // gets the float result through scratch and is encoded on the way in
+
+        if constexpr (layout == DelayLayout::laned)
+        {
+            // Each group is mixed and written a frame per vector, between two transposes of its input
+            auto* ioFrames = core.laneFrames.getWritePointer(numGroups);
+
+            for (int group = 0; group < numGroups; ++group)
+            {
+                auto first = group * lanes;
+                auto count = juce::jmin(lanes, numChannels - first);
+                SampleType* io[lanes] = {};
+
+                for (int lane = 0; lane < count; ++lane)
+                    io[lane] = subBlock.getWritePointer(first + lane, done);
+
+                auto* frames = ring.getWritePointer(first, writePosition);
+                SampleType* destination;
+
+                if constexpr (isDirect)
+                    destination = frames;
+                else
+                    destination = m_writeScratch.getWritePointer(0);
+
+                kernels.interleaveLanes(io, count, ioFrames, numSamples);
+                kernels.readMixWriteLanes(ioFrames, destination, lanedFrames[group],
+                                          parameters.wetGain + done, parameters.feedback + done, numSamples);
+                kernels.deinterleaveLanes(ioFrames, count, io, numSamples);
+
+                if constexpr (! isDirect)
+                    kernels.encodeHalf(destination, frames, 1, lanes * numSamples);
+
+                ring.mirrorFrames(first, writePosition, numSamples);
+            }
+        }
+        else if constexpr (layout == DelayLayout::interleaved)
+        {
+            auto* frames = ring.getWritePointer(0, writePosition);
+            SampleType* destination;
+
+            if constexpr (isDirect)
+                destination = frames;
+            else
+                destination = m_writeScratch.getWritePointer(0);
+
+            kernels.readMixWriteStereo(subBlock.getWritePointer(0, done),
+                                       subBlock.getWritePointer(1, done),
+                                       destination,
+                                       delayed[0],
+                                       delayed[1],
+                                       parameters.wetGain + done,
+                                       parameters.feedback + done,
+                                       numSamples);
+
+            if constexpr (! isDirect)
+                kernels.encodeHalf(destination, frames, 1, 2 * numSamples);
+
+            ring.mirror(0, writePosition, numSamples);
+            ring.mirror(1, writePosition, numSamples);
+        }
+        else
+        {
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                auto* stored = ring.getWritePointer(channel, writePosition);
+                SampleType* destination;
+
+                if constexpr (isDirect)
+                    destination = stored;
+                else
+                    destination = m_writeScratch.getWritePointer(0);
+
+                kernels.readMixWrite(subBlock.getWritePointer(channel, done),
+                                     destination,
+                                     delayed[channel],
+                                     parameters.wetGain + done,
+                                     parameters.feedback + done,
+                                     numSamples);
+
+                if constexpr (! isDirect)
+                    kernels.encodeHalf(destination, stored, 1, numSamples);
+
+                ring.mirror(channel, writePosition, numSamples);
+            }
+        }
+
+        done += numSamples;
+    }
+
+    ring.advance(bufferSize);
+}
 
 //==============================================================================
 bool FractureAudioProcessor::hasEditor() const
@@ -292,15 +710,44 @@ juce::AudioProcessorEditor* FractureAudioProcessor::createEditor()
 //==============================================================================
 void FractureAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-	// You should use this method to store your parameters in the memory block.
-	// You could do that either as raw data, or use the XML or ValueTree classes
-	// as intermediaries to make it easy to save and load complex data.
+	// A versioned binary chunk; see StateRecall for the format
+	m_stateRecall.writeState(destData);
+
+	// A loaded impulse response is saved by its path; the audio is too big to carry
+	auto impulseFile = m_smear.getImpulseFile();
+
+	if (impulseFile != juce::File())
+	{
+		auto path = impulseFile.getFullPathName();
+		StateRecall::appendChunk(destData, StateRecall::impulseChunk, juce::MemoryBlock(path.toRawUTF8(), path.getNumBytesAsUTF8()));
+	}
 }
 
 void FractureAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-	// You should use this method to restore your parameters from this memory block,
-	// whose contents will have been created by the getStateInformation() call.
+	// Applied at once while stopped, otherwise behind a short fade of the wet path
+	if (! m_stateRecall.readState(data, sizeInBytes))
+		return;
+
+	// The smear fades to its new impulse response by itself. One whose file has gone
+	// missing falls back to the generated one
+	juce::MemoryBlock path;
+
+	if (! StateRecall::findChunk(data, static_cast<size_t>(sizeInBytes), StateRecall::impulseChunk, path)
+		|| m_smear.loadImpulseResponse(juce::File(path.toString())).failed())
+		m_smear.clearImpulseResponse();
+}
+
+bool FractureAudioProcessor::loadPreset(int index)
+{
+    // The state is read straight out of the mapped file
+    auto state = m_presetLibrary.getState(index);
+
+    if (state.data == nullptr)
+        return false;
+
+    setStateInformation(state.data, static_cast<int>(state.size));
+    return true;
 }
 
 //==============================================================================
@@ -316,13 +763,58 @@ juce::AudioProcessorValueTreeState::ParameterLayout FractureAudioProcessor::crea
 
     params.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "DRYWET", 1 }, "Dry/Wet", 0.0f, 100.0f, 0.0f));
 
-    params.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "DELAYTIME", 1 }, "Delay", 0.5f, 500.0f, 0.0f));
+    // The line reaches back the longest DELAYTIME plus the longest STEREO, and no tap further
+    constexpr auto maxDelayTimeMs = 500.0f, maxStereoMs = 400.0f;
+
+    params.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "DELAYTIME", 1 }, "Delay", 0.5f, maxDelayTimeMs, 0.0f));
 
     params.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "FEEDBACK", 1 }, "Feedback", 0.0f, 1.0f, 0.0f));
 
-    params.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "STEREO", 1 }, "Stereo", 0.0f, 400.0f, 0.0f));
+    params.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "STEREO", 1 }, "Stereo", 0.0f, maxStereoMs, 0.0f));
 
 	params.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "SHAKE", 1 }, "Shake", 0.0f, 10.0f, 2.0f));
 
+	params.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{ "INTERP", 1 }, "Interpolation",
+															juce::StringArray{ "Linear", "Lagrange", "Hermite" }, 0));
+
+	params.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{ "MODE", 1 }, "Mode",
+															juce::StringArray{ "Single", "Multi-Tap", "Diffuse" }, 0));
+
+	params.add(std::make_unique<juce::AudioParameterInt>(juce::ParameterID{ "TAPS", 1 }, "Taps", 1, MultiTapEngine::maxTaps, 6));
+
+	params.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID{ "TAPLAYOUT", 1 }, "Tap Layout",
+															juce::StringArray{ "Echoes", "Manual" }, 0));
+
+	// Manual taps start out as the echoes of a 50 ms delay, fading and spreading out
+	for (int tap = 0; tap < MultiTapEngine::maxTaps; ++tap)
+	{
+		auto id = "TAP" + juce::String(tap + 1);
+		auto name = "Tap " + juce::String(tap + 1);
+		auto side = tap % 2 == 0 ? 1.0f : -1.0f;
+
+		params.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ id + "TIME", 1 }, name + " Time",
+															   0.5f, maxDelayTimeMs + maxStereoMs, 50.0f * static_cast<float>(tap + 1)));
+
+		params.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ id + "GAIN", 1 }, name + " Gain",
+															   0.0f, 1.0f, std::pow(0.8f, static_cast<float>(tap))));
+
+		params.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ id + "PAN", 1 }, name + " Pan",
+															   -1.0f, 1.0f, side * static_cast<float>(tap + 1) / static_cast<float>(MultiTapEngine::maxTaps)));
+	}
+
+	params.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "LOWCUT", 1 }, "Low Cut",
+														   juce::NormalisableRange<float>(FeedbackFilter<float>::minimumLowCut, 2000.0f, 1.0f, 0.3f),
+														   FeedbackFilter<float>::minimumLowCut));
+
+	params.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "HIGHCUT", 1 }, "High Cut",
+														   juce::NormalisableRange<float>(1000.0f, FeedbackFilter<float>::maximumHighCut, 1.0f, 0.3f),
+														   FeedbackFilter<float>::maximumHighCut));
+
+	params.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "SMEAR", 1 }, "Smear", 0.0f, 100.0f, 0.0f));
+
+	params.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID{ "SMEARTIME", 1 }, "Smear Time",
+														   juce::NormalisableRange<float>(0.1f, static_cast<float>(SmearConvolver::maxImpulseSeconds), 0.01f, 0.5f),
+														   1.5f));
+
 	return params;
 }
\ No newline at end of file
@@ -9,6 +9,23 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "CoefficientWorker.h"
+#include "DelayRingBuffer.h"
+#include "DiffusionNetwork.h"
+#include "FeedbackFilter.h"
+#include "FractionalReadHead.h"
+#include "HalfFloat.h"
+#include "IdleDetector.h"
+#include "KernelDispatch.h"
+#include "LanedReadHead.h"
+#include "MultiTapEngine.h"
+#include "ParameterEngine.h"
+#include "PerformanceMonitor.h"
+#include "PresetLibrary.h"
+#include "SignalTelemetry.h"
+#include "SmearConvolver.h"
+#include "SpeakerLayout.h"
+#include "StateRecall.h"
 
 //==============================================================================
 /**
@@ -23,12 +40,16 @@ public:
     //==============================================================================
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
+    void setNonRealtime (bool isNonRealtime) noexcept override;
 
    #ifndef JucePlugin_PreferredChannelConfigurations
     bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+
+    bool supportsDoublePrecisionProcessing() const override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -55,23 +76,156 @@ public:
 
 	juce::AudioProcessorValueTreeState apvts;
 
+	PerformanceMonitor& getPerformanceMonitor() noexcept { return m_performanceMonitor; }
+
+	/** The preset library from PresetLibrary::getDefaultFile(), mapped when the processor is made. */
+	const PresetLibrary& getPresetLibrary() const noexcept { return m_presetLibrary; }
+
+	/** Moves to a newer version of the library if one was written. Message thread; true if
+		it did, which makes every preset index from before stale.
+	*/
+	bool refreshPresetLibrary() { return m_presetLibrary.refresh(); }
+
+	/** Recalls a preset from the library through setStateInformation(). Message thread. */
+	bool loadPreset(int index);
+
+	/** Smears the repeats with an audio file's impulse response instead of the generated one,
+		by as much as SMEAR says. It is saved with the state by its path. Message thread.
+	*/
+	juce::Result loadImpulseResponse(const juce::File& file) { return m_smear.loadImpulseResponse(file); }
+	void clearImpulseResponse() { m_smear.clearImpulseResponse(); }
+	juce::File getImpulseFile() const { return m_smear.getImpulseFile(); }
+
+	/** Latest levels of the signal and its repeats, for the visuals. Any number of readers. */
+	const TelemetryBus& getTelemetryBus() const noexcept { return m_telemetry.getBus(); }
+
+	/** Storage layout of the delay line from the next prepareToPlay on. Only a
+		stereo bus uses the interleaved layout, and a mono one stays planar. A bus
+		wider than stereo always uses the laned layout, processed a group of
+		channels per vector.
+	*/
+	void setDelayLayout(DelayLayout layout) noexcept { m_requestedDelayLayout = layout; }
+
+	/** Stores the delay line in half precision from the next prepareToPlay on,
+		for half the memory per instance. Processing stays in float, and a host
+		that runs the plugin in double precision gets a double line regardless.
+	*/
+	void setHalfPrecisionDelay(bool shouldUseHalfPrecision) noexcept { m_halfPrecisionRequested = shouldUseHalfPrecision; }
+
+	/** Number of lines of the diffuse mode's network from the next prepareToPlay on:
+		8 (the default) or 16, for a denser tail at twice the cost.
+	*/
+	void setDiffusionLines(int numLines) noexcept { m_requestedDiffusionLines = numLines; }
+
+	/** Instruction set of the DSP kernels from the next prepareToPlay on. By default
+		the best one the CPU supports; anything it can't run falls back to that too.
+	*/
+	void setKernelIsa(KernelDispatch::Isa isa) noexcept { m_requestedKernelIsa = isa; }
+
+	/** The instruction set the kernels are running with. */
+	KernelDispatch::Isa getKernelIsa() const noexcept { return m_kernels->isa; }
+
 private:
     //==============================================================================
     juce::AudioProcessorValueTreeState::ParameterLayout createParameters();
 
-	juce::AudioBuffer<float> m_delayBuffer;
+    // Internal processing granularity; also the span size everything is prepared for
+    static constexpr int subBlockSize = 64;
+
+    // The sub-block processing is specialised at compile time for the processing precision,
+    // storage format, channel count, delay line layout, mode, interpolator and feedback filter
+    // state. selectKernel() picks one in prepareToPlay and again whenever the mode, the
+    // interpolator or the filter state changes; processBlock only calls through the kernel.
+    template <typename SampleType>
+    using SubBlockKernel = void (FractureAudioProcessor::*)(juce::AudioBuffer<SampleType>&, const SmoothedParameters&);
+
+    // The stages that carry audio in one processing precision. Both sets are prepared, and
+    // the host's precision decides which one runs; float and double share all the code.
+    template <typename SampleType>
+    struct ProcessingCore
+    {
+        juce::OwnedArray<FractionalReadHead<SampleType>> readHeads;
+        juce::OwnedArray<LanedReadHead<SampleType>> lanedReadHeads;    // one per channel group of a laned line
+        juce::AudioBuffer<SampleType> laneChannels;                     // a laned line's delayed signal, planar for the filter
+        juce::AudioBuffer<SampleType> laneFrames;                       // filtered frames per group, then the input's
+        FeedbackFilter<SampleType> feedbackFilter;
+        SubBlockKernel<SampleType> kernel = nullptr;
+    };
+
+	SpeakerLayout m_speakerLayout;
+	ParameterEngine m_parameters{ apvts };
+	DelayRingBuffer<float> m_delayBuffer;
+	DelayRingBuffer<HalfFloat::Bits> m_halfDelayBuffer;
+	DelayRingBuffer<double> m_doubleDelayBuffer;
+	DelayLayout m_requestedDelayLayout = DelayLayout::planar;
+	bool m_halfPrecisionRequested = FRACTURE_HALF_PRECISION_DELAY;
+	bool m_halfPrecision = false;
+	bool m_doublePrecision = false;
+	KernelDispatch::Isa m_requestedKernelIsa = KernelDispatch::Isa::automatic;
+	const KernelDispatch::Table* m_kernels = KernelDispatch::getTable(KernelDispatch::Isa::automatic);
+	juce::AudioBuffer<float> m_writeScratch;
+	ProcessingCore<float> m_floatCore;
+	ProcessingCore<double> m_doubleCore;
+	MultiTapEngine m_multiTap;
+	DiffusionNetwork m_diffusion;
+	int m_requestedDiffusionLines = 8;
+	IdleDetector m_idleDetector;
+	PerformanceMonitor m_performanceMonitor;
+	SignalTelemetry m_telemetry;
+	CoefficientWorker m_coefficientWorker{ apvts };
+	SmearConvolver m_smear{ apvts };
+	StateRecall m_stateRecall{ apvts };
+	PresetLibrary m_presetLibrary;
     int m_sampleRate;
 	int m_samplesPerBlock;
-    int m_writePosition{ 0 };
-
-	juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> m_delayLine;
-	juce::dsp::IIR::Filter<float> m_filter;
-
-    void fillBuffer(juce::AudioBuffer<float>& buffer, int channel);
-    void feedbackBuffer(juce::AudioBuffer<float>& buffer, int channel);
-    void readFromBuffer(juce::AudioBuffer<float>& buffer, juce::AudioBuffer<float>& delayBuffer, int channel);
-    void updateBufferPositions(juce::AudioBuffer<float>& buffer, juce::AudioBuffer<float>& delayBuffer);
 
+    DelayMode m_kernelMode = DelayMode::single;
+    Interpolation m_kernelInterpolation = Interpolation::linear;
+    bool m_kernelFiltered = false;
+
+    template <typename SampleType>
+    void prepareCore(ProcessingCore<SampleType>& core, DelayLayout layout);
+
+    template <typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer);
+
+    void selectKernel(DelayMode mode, Interpolation interpolation, bool filtered) noexcept;
+
+    template <typename SampleType, typename StorageType>
+    SubBlockKernel<SampleType> getKernel(DelayMode mode, Interpolation interpolation, bool filtered) noexcept;
+
+    template <typename SampleType, typename StorageType, int fixedChannels, DelayLayout layout>
+    static SubBlockKernel<SampleType> getDelayKernel(Interpolation interpolation, bool filtered) noexcept;
+
+    template <typename SampleType>
+    ProcessingCore<SampleType>& getCore() noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, float>)
+            return m_floatCore;
+        else
+            return m_doubleCore;
+    }
+
+    template <typename StorageType>
+    DelayRingBuffer<StorageType>& getDelayBuffer() noexcept
+    {
+        if constexpr (std::is_same_v<StorageType, float>)
+            return m_delayBuffer;
+        else if constexpr (std::is_same_v<StorageType, double>)
+            return m_doubleDelayBuffer;
+        else
+            return m_halfDelayBuffer;
+    }
+
+    template <typename SampleType, typename StorageType>
+    void processMultiTap(juce::AudioBuffer<SampleType>& subBlock, const SmoothedParameters& parameters);
+
+    template <typename SampleType>
+    void processDiffuse(juce::AudioBuffer<SampleType>& subBlock, const SmoothedParameters& parameters);
+
+    // fixedChannels of 0 takes the channel count from the buffer
+    template <typename SampleType, typename StorageType, int fixedChannels, DelayLayout layout, Interpolation interpolation, bool filtered>
+    void processDelay(juce::AudioBuffer<SampleType>& subBlock, const SmoothedParameters& parameters);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FractureAudioProcessor)
 };
\ No newline at end of file
@@ -0,0 +1,420 @@
+/*
+  ==============================================================================
+
+    PresetLibrary.cpp
+    Created: 22 Oct 2026 3:46:05pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#include "PresetLibrary.h"
+
+#include <map>
+#include <numeric>
+
+namespace
+{
+    constexpr juce::uint32 magic = 0x4c505246;     // "FRPL"
+    constexpr int formatVersion = 1;
+    constexpr size_t headerSize = 36;
+    constexpr juce::uint32 recordSize = 16;         // name offset, name length, state offset, state size
+    constexpr juce::uint32 tagSize = 16;            // name offset, name length, first posting, number of postings
+
+    // Names are ordered and matched byte by byte with only A-Z folded, so the
+    // order the builder writes is the order a reader searches, on any system
+    unsigned char fold (char c) noexcept
+    {
+        auto byte = static_cast<unsigned char> (c);
+        return byte >= 'A' && byte <= 'Z' ? static_cast<unsigned char> (byte + ('a' - 'A')) : byte;
+    }
+
+    int compareFolded (const char* a, size_t aLength, const char* b, size_t bLength) noexcept
+    {
+        for (size_t i = 0; i < juce::jmin (aLength, bLength); ++i)
+            if (fold (a[i]) != fold (b[i]))
+                return fold (a[i]) < fold (b[i]) ? -1 : 1;
+
+        return aLength == bLength ? 0 : (aLength < bLength ? -1 : 1);
+    }
+
+    bool containsFolded (const char* text, size_t textLength, const char* part, size_t partLength) noexcept
+    {
+        for (size_t start = 0; start + partLength <= textLength; ++start)
+            if (compareFolded (text + start, partLength, part, partLength) == 0)
+                return true;
+
+        return false;
+    }
+
+    bool isLessFolded (const juce::String& a, const juce::String& b) noexcept
+    {
+        return compareFolded (a.toRawUTF8(), a.getNumBytesAsUTF8(), b.toRawUTF8(), b.getNumBytesAsUTF8()) < 0;
+    }
+}
+
+//==============================================================================
+juce::File PresetLibrary::getDefaultFile()
+{
+    return juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
+        .getChildFile ("Fracture")
+        .getChildFile ("Presets.frpl");
+}
+
+juce::File PresetLibrary::getVersionFile (const juce::File& library, int version)
+{
+    return version == 0 ? library
+                        : library.getSiblingFile (library.getFileNameWithoutExtension() + "." + juce::String (version) + library.getFileExtension());
+}
+
+int PresetLibrary::getVersion (const juce::File& file, const juce::File& library)
+{
+    // "Name.<n>.ext" is version n, and the library file itself version 0
+    auto prefix = library.getFileNameWithoutExtension() + ".";
+    auto name = file.getFileNameWithoutExtension();
+
+    if (! name.startsWith (prefix))
+        return 0;
+
+    auto number = name.substring (prefix.length());
+    return number.isNotEmpty() && number.containsOnly ("0123456789") ? number.getIntValue() : 0;
+}
+
+juce::Array<juce::File> PresetLibrary::findVersions (const juce::File& library)
+{
+    auto versions = library.getParentDirectory().findChildFiles (juce::File::findFiles, false,
+                                                                 library.getFileNameWithoutExtension() + ".*" + library.getFileExtension());
+    versions.removeIf ([&library] (const juce::File& file) { return getVersion (file, library) == 0; });
+
+    if (library.existsAsFile())
+        versions.add (library);
+
+    return versions;
+}
+
+juce::File PresetLibrary::getLatestVersion (const juce::File& file)
+{
+    auto latest = file;
+
+    for (auto& version : findVersions (file))
+        if (getVersion (version, file) > getVersion (latest, file))
+            latest = version;
+
+    return latest;
+}
+
+bool PresetLibrary::open (const juce::File& file)
+{
+    close();
+
+    // Kept even if this version fails, so that refresh() picks up the next one
+    m_library = file;
+    m_openedVersion = getLatestVersion (file);
+
+    auto mapped = std::make_unique<juce::MemoryMappedFile> (m_openedVersion, juce::MemoryMappedFile::readOnly);
+
+    if (mapped->getData() == nullptr || mapped->getSize() < headerSize)
+        return false;
+
+    m_data = static_cast<const char*> (mapped->getData());
+    m_size = mapped->getSize();
+
+    // Every table has to fit in the file; the records' own offsets are checked on use
+    auto fits = [this] (juce::uint32 offset, juce::uint32 count, juce::uint32 size)
+    {
+        return static_cast<juce::uint64> (offset) + static_cast<juce::uint64> (count) * size <= m_size;
+    };
+
+    m_recordSize = juce::ByteOrder::littleEndianShort (m_data + 6);
+    m_numRecords = readWord (8);
+    m_recordsOffset = readWord (12);
+    m_nameIndexOffset = readWord (16);
+    m_numTags = readWord (20);
+    m_tagsOffset = readWord (24);
+    m_postingsOffset = readWord (28);
+    m_numPostings = readWord (32);
+
+    if (readWord (0) != magic || juce::ByteOrder::littleEndianShort (m_data + 4) < 1 || m_recordSize < recordSize
+        || ! fits (m_recordsOffset, m_numRecords, m_recordSize) || ! fits (m_nameIndexOffset, m_numRecords, 4)
+        || ! fits (m_tagsOffset, m_numTags, tagSize) || ! fits (m_postingsOffset, m_numPostings, 4))
+    {
+        unmap();
+        return false;
+    }
+
+    m_file = std::move (mapped);
+    return true;
+}
+
+void PresetLibrary::close()
+{
+    m_library = m_openedVersion = juce::File();
+    unmap();
+}
+
+void PresetLibrary::unmap() noexcept
+{
+    m_file.reset();
+    m_data = nullptr;
+    m_size = 0;
+    m_numRecords = m_numTags = m_numPostings = 0;
+}
+
+bool PresetLibrary::refresh()
+{
+    if (m_library == juce::File() || getLatestVersion (m_library) == m_openedVersion)
+        return false;
+
+    // The library stays empty if the new version turns out not to be one
+    auto library = m_library;
+    open (library);
+    return true;
+}
+
+juce::String PresetLibrary::getName (int index) const
+{
+    auto name = getNameText (index);
+    return juce::String::fromUTF8 (name.data, static_cast<int> (name.length));
+}
+
+PresetLibrary::State PresetLibrary::getState (int index) const noexcept
+{
+    if (! juce::isPositiveAndBelow (index, getNumPresets()))
+        return {};
+
+    auto record = m_recordsOffset + static_cast<size_t> (index) * m_recordSize;
+    auto state = getText (readWord (record + 8), readWord (record + 12));
+    return { state.data, state.length };
+}
+
+juce::String PresetLibrary::getTag (int tagIndex) const
+{
+    auto tag = getTagText (tagIndex);
+    return juce::String::fromUTF8 (tag.data, static_cast<int> (tag.length));
+}
+
+int PresetLibrary::findPreset (const juce::String& name) const
+{
+    auto* query = name.toRawUTF8();
+    auto queryLength = name.getNumBytesAsUTF8();
+    int low = 0, high = getNumPresets();
+
+    while (low < high)
+    {
+        auto middle = (low + high) / 2;
+        auto record = static_cast<int> (readWord (m_nameIndexOffset + static_cast<size_t> (middle) * 4));
+        auto candidate = getNameText (record);
+        auto order = compareFolded (candidate.data, candidate.length, query, queryLength);
+
+        if (order == 0)
+            return record;
+
+        if (order < 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return -1;
+}
+
+juce::Array<int> PresetLibrary::search (const juce::String& text, int maxResults) const
+{
+    juce::Array<int> results;
+    auto* part = text.toRawUTF8();
+    auto partLength = text.getNumBytesAsUTF8();
+
+    for (int i = 0; i < getNumPresets() && results.size() < maxResults; ++i)
+    {
+        auto record = static_cast<int> (readWord (m_nameIndexOffset + static_cast<size_t> (i) * 4));
+        auto name = getNameText (record);
+
+        if (name.data != nullptr && containsFolded (name.data, name.length, part, partLength))
+            results.add (record);
+    }
+
+    return results;
+}
+
+juce::Array<int> PresetLibrary::getPresetsWithTag (const juce::String& tag) const
+{
+    juce::Array<int> results;
+    auto tagIndex = findTag ({ tag.toRawUTF8(), tag.getNumBytesAsUTF8() });
+
+    if (tagIndex < 0)
+        return results;
+
+    auto entry = m_tagsOffset + static_cast<size_t> (tagIndex) * tagSize;
+    auto first = readWord (entry + 8);
+    auto count = juce::jmin (readWord (entry + 12), m_numPostings - juce::jmin (first, m_numPostings));
+
+    for (juce::uint32 i = 0; i < count; ++i)
+    {
+        auto record = static_cast<int> (readWord (m_postingsOffset + static_cast<size_t> (first + i) * 4));
+
+        if (juce::isPositiveAndBelow (record, getNumPresets()))
+            results.add (record);
+    }
+
+    return results;
+}
+
+//==============================================================================
+juce::uint32 PresetLibrary::readWord (size_t offset) const noexcept
+{
+    return offset + 4 <= m_size ? juce::ByteOrder::littleEndianInt (m_data + offset) : 0;
+}
+
+PresetLibrary::Text PresetLibrary::getText (size_t offset, size_t length) const noexcept
+{
+    if (offset > m_size || length > m_size - offset)
+        return {};
+
+    return { m_data + offset, length };
+}
+
+PresetLibrary::Text PresetLibrary::getNameText (int index) const noexcept
+{
+    if (! juce::isPositiveAndBelow (index, getNumPresets()))
+        return {};
+
+    auto record = m_recordsOffset + static_cast<size_t> (index) * m_recordSize;
+    return getText (readWord (record), readWord (record + 4));
+}
+
+PresetLibrary::Text PresetLibrary::getTagText (int tagIndex) const noexcept
+{
+    if (! juce::isPositiveAndBelow (tagIndex, getNumTags()))
+        return {};
+
+    auto entry = m_tagsOffset + static_cast<size_t> (tagIndex) * tagSize;
+    return getText (readWord (entry), readWord (entry + 4));
+}
+
+int PresetLibrary::findTag (const Text& tag) const noexcept
+{
+    int low = 0, high = getNumTags();
+
+    while (low < high)
+    {
+        auto middle = (low + high) / 2;
+        auto candidate = getTagText (middle);
+        auto order = compareFolded (candidate.data, candidate.length, tag.data, tag.length);
+
+        if (order == 0)
+            return middle;
+
+        if (order < 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return -1;
+}
+
+//==============================================================================
+void PresetLibrary::Builder::add (const juce::String& name, const juce::StringArray& tags, const juce::MemoryBlock& state)
+{
+    m_presets.push_back ({ name, tags, state });
+}
+
+juce::Result PresetLibrary::Builder::write (const juce::File& file) const
+{
+    auto numRecords = static_cast<juce::uint32> (m_presets.size());
+
+    std::vector<juce::uint32> nameOrder (numRecords);
+    std::iota (nameOrder.begin(), nameOrder.end(), 0u);
+    std::stable_sort (nameOrder.begin(), nameOrder.end(), [this] (juce::uint32 a, juce::uint32 b)
+    {
+        return isLessFolded (m_presets[a].name, m_presets[b].name);
+    });
+
+    // Tags that differ only in ASCII case are one tag, spelt as it was first added
+    std::map<juce::String, std::vector<juce::uint32>, decltype (&isLessFolded)> tags (&isLessFolded);
+
+    for (juce::uint32 record = 0; record < numRecords; ++record)
+        for (auto& tag : m_presets[record].tags)
+            if (tag.isNotEmpty())
+                tags[tag].push_back (record);
+
+    auto numTags = static_cast<juce::uint32> (tags.size());
+    juce::uint32 numPostings = 0;
+
+    for (auto& tag : tags)
+        numPostings += static_cast<juce::uint32> (tag.second.size());
+
+    auto recordsOffset = static_cast<juce::uint32> (headerSize);
+    auto nameIndexOffset = recordsOffset + numRecords * recordSize;
+    auto tagsOffset = nameIndexOffset + numRecords * 4;
+    auto postingsOffset = tagsOffset + numTags * tagSize;
+    auto dataOffset = postingsOffset + numPostings * 4;
+
+    juce::MemoryOutputStream tables, data;
+
+    auto addData = [&] (const void* bytes, size_t size)
+    {
+        auto offset = dataOffset + static_cast<juce::uint32> (data.getDataSize());
+        data.write (bytes, size);
+        tables.writeInt (static_cast<int> (offset));
+        tables.writeInt (static_cast<int> (size));
+    };
+
+    tables.writeInt (static_cast<int> (magic));
+    tables.writeShort (static_cast<short> (formatVersion));
+    tables.writeShort (static_cast<short> (recordSize));
+
+    for (auto word : { numRecords, recordsOffset, nameIndexOffset, numTags, tagsOffset, postingsOffset, numPostings })
+        tables.writeInt (static_cast<int> (word));
+
+    for (auto& preset : m_presets)
+    {
+        addData (preset.name.toRawUTF8(), preset.name.getNumBytesAsUTF8());
+        addData (preset.state.getData(), preset.state.getSize());
+    }
+
+    for (auto record : nameOrder)
+        tables.writeInt (static_cast<int> (record));
+
+    juce::uint32 firstPosting = 0;
+
+    for (auto& tag : tags)
+    {
+        addData (tag.first.toRawUTF8(), tag.first.getNumBytesAsUTF8());
+        tables.writeInt (static_cast<int> (firstPosting));
+        tables.writeInt (static_cast<int> (tag.second.size()));
+        firstPosting += static_cast<juce::uint32> (tag.second.size());
+    }
+
+    for (auto& tag : tags)
+        for (auto record : tag.second)
+            tables.writeInt (static_cast<int> (record));
+
+    jassert (tables.getDataSize() == dataOffset);
+
+    if (static_cast<juce::uint64> (dataOffset) + data.getDataSize() > std::numeric_limits<juce::uint32>::max())
+        return juce::Result::fail ("The library would be larger than 4 GB");
+
+    // Nobody has a new version mapped, so it can always be moved into place
+    auto latest = getLatestVersion (file);
+    auto target = getVersionFile (file, getVersion (latest, file) + 1);
+    juce::TemporaryFile temporary (target);
+
+    {
+        juce::FileOutputStream output (temporary.getFile());
+
+        if (! output.openedOk() || ! output.write (tables.getData(), tables.getDataSize())
+            || ! output.write (data.getData(), data.getDataSize()))
+            return juce::Result::fail ("Could not write " + temporary.getFile().getFullPathName());
+    }
+
+    if (! temporary.overwriteTargetFileWithTemporary())
+        return juce::Result::fail ("Could not write " + target.getFullPathName());
+
+    // Deleting a version that is still mapped fails on Windows; the next write tries again
+    for (auto& version : findVersions (file))
+        if (version != target)
+            version.deleteFile();
+
+    return juce::Result::ok();
+}
@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+    PresetLibrary.h
+    Created: 22 Oct 2026 3:46:05pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    A whole preset library in one file, memory-mapped and read in place.
+
+    The file is a fixed header followed by a table of fixed-size records, a
+    name index, a tag table and its postings, and the string and state data
+    the records point into, little-endian throughout:
+
+        header      "FRPL", version, record size, then the count and offset of
+                    every table
+        records     per preset: name offset and length, state offset and size
+        name index  record numbers, sorted by name ignoring ASCII case
+        tags        per tag, sorted by name: name offset and length, first
+                    posting and number of postings
+        postings    record numbers, grouped by tag
+        data        UTF-8 names and the presets' states, as StateRecall writes them
+
+    Opening maps the file and checks the header, so it takes the same time
+    however many presets there are. Preset n is at a fixed offset, a name or
+    a tag is a binary search, and a preset's state is handed out as a pointer
+    into the mapping, ready for setStateInformation(). Nothing is parsed or
+    copied up front. The record size is stored in the header, so a later
+    version can add fields to the records without breaking older readers.
+
+    A mapped file can't be replaced on Windows, so a library is never
+    rewritten in place. Each write adds a numbered version next to the file
+    it is given ("Presets.frpl" becomes "Presets.2.frpl" and so on), and
+    opening takes the newest one. A running instance keeps the version it
+    mapped until refresh() moves it on to a newer one.
+*/
+class PresetLibrary
+{
+public:
+    /** A preset's state, pointing into the mapped file. */
+    struct State
+    {
+        const void* data = nullptr;
+        size_t size = 0;
+    };
+
+    PresetLibrary() = default;
+
+    /** Where the editor and the command line look by default. */
+    static juce::File getDefaultFile();
+
+    /** The newest version written for a library file, or the file itself if it has none. */
+    static juce::File getLatestVersion (const juce::File& file);
+
+    /** Maps in the newest version of the library. Returns false, leaving the
+        library empty, if there is none or it isn't a library.
+    */
+    bool open (const juce::File& file);
+    void close();
+
+    /** Reopens the library if a newer version has been written since it was
+        opened. True if it did: every index handed out before is stale.
+    */
+    bool refresh();
+
+    bool isOpen() const noexcept                    { return m_file != nullptr; }
+    int getNumPresets() const noexcept              { return static_cast<int> (m_numRecords); }
+    int getNumTags() const noexcept                 { return static_cast<int> (m_numTags); }
+
+    juce::String getName (int index) const;
+    State getState (int index) const noexcept;
+    juce::String getTag (int tagIndex) const;
+
+    /** The preset with exactly this name, ignoring ASCII case, or -1. */
+    int findPreset (const juce::String& name) const;
+
+    /** Presets whose names contain the text, ignoring ASCII case, in name order.
+        An empty text matches every preset.
+    */
+    juce::Array<int> search (const juce::String& text, int maxResults) const;
+
+    /** Presets with the tag, ignoring ASCII case, in the order they were added. */
+    juce::Array<int> getPresetsWithTag (const juce::String& tag) const;
+
+    //==============================================================================
+    /** Collects presets and writes them out as a library file. */
+    class Builder
+    {
+    public:
+        Builder() = default;
+
+        void add (const juce::String& name, const juce::StringArray& tags, const juce::MemoryBlock& state);
+        int getNumPresets() const noexcept          { return static_cast<int> (m_presets.size()); }
+
+        /** Writes the library as a new version of the file, complete before any
+            reader can see it. Older versions are deleted, except those another
+            instance still has mapped, which go on a later write.
+        */
+        juce::Result write (const juce::File& file) const;
+
+    private:
+        struct Preset
+        {
+            juce::String name;
+            juce::StringArray tags;
+            juce::MemoryBlock state;
+        };
+
+        std::vector<Preset> m_presets;
+    };
+
+private:
+    struct Text
+    {
+        const char* data = nullptr;
+        size_t length = 0;
+    };
+
+    juce::uint32 readWord (size_t offset) const noexcept;
+    Text getText (size_t offset, size_t length) const noexcept;
+    Text getNameText (int index) const noexcept;
+    Text getTagText (int tagIndex) const noexcept;
+    int findTag (const Text& tag) const noexcept;
+
+    void unmap() noexcept;
+
+    static int getVersion (const juce::File& file, const juce::File& library);
+    static juce::File getVersionFile (const juce::File& library, int version);
+    static juce::Array<juce::File> findVersions (const juce::File& library);
+
+    juce::File m_library, m_openedVersion;
+    std::unique_ptr<juce::MemoryMappedFile> m_file;
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+    juce::uint32 m_numRecords = 0, m_recordSize = 0, m_recordsOffset = 0, m_nameIndexOffset = 0;
+    juce::uint32 m_numTags = 0, m_tagsOffset = 0, m_postingsOffset = 0, m_numPostings = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (PresetLibrary)
+};
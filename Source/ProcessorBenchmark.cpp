@@ -0,0 +1,443 @@
+/*
+  ==============================================================================
+
+    ProcessorBenchmark.cpp
+    Created: 18 Oct 2026 10:12:31am
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#include "ProcessorBenchmark.h"
+#include "PluginProcessor.h"
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+//==============================================================================
+juce::String ProcessorBenchmark::Config::getName() const
+{
+    return juce::String (static_cast<int> (sampleRate)) + "Hz/"
+         + juce::String (blockSize) + "smp/"
+         + juce::String (numChannels) + "ch/"
+         + presetName
+         + (interleaved ? "/interleaved" : "")
+         + (halfPrecision ? "/half" : "")
+         + (doublePrecision ? "/double" : "")
+         + (diffusionLines > 0 ? "/diffuse" + juce::String (diffusionLines) : juce::String())
+         + (smear ? "/smear" : "")
+         + (isa != KernelDispatch::Isa::automatic ? "/" + juce::String (KernelDispatch::getName (isa)).toLowerCase() : juce::String());
+}
+
+ProcessorBenchmark::ProcessorBenchmark (Options options)
+    : m_options (options)
+{
+}
+
+juce::Array<ProcessorBenchmark::Config> ProcessorBenchmark::createMatrix (bool quick, bool compareLayouts, bool compareStorage,
+                                                                          bool compareIsas, bool comparePrecision,
+                                                                          bool compareDiffusion, bool compareSmear)
+{
+    juce::Array<double> sampleRates { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+    juce::Array<int> blockSizes { 1, 16, 32, 64, 512, 4096, 37, 441, 1023 };
+    juce::Array<int> channelCounts { 1, 2, 6, 12, 16 };
+
+    // DRYWET, DELAYTIME, FEEDBACK, STEREO
+    struct Preset { const char* name; float dryWet, delayTime, feedback, stereo; };
+    const Preset presets[] = {
+        { "default",      50.0f,  50.0f, 0.2f,   0.0f },
+        { "dry",           0.0f,   0.5f, 0.0f,   0.0f },
+        { "wide",         50.0f, 250.0f, 0.5f, 400.0f },
+        { "maxfeedback", 100.0f, 500.0f, 1.0f, 200.0f },
+    };
+
+    if (quick)
+    {
+        sampleRates = { 48000.0, 192000.0 };
+        blockSizes = { 1, 64, 512, 441 };
+        channelCounts = { 2 };
+    }
+
+    juce::Array<KernelDispatch::Isa> isas { KernelDispatch::Isa::automatic };
+
+    if (compareIsas)
+    {
+        isas.clear();
+
+        for (auto isa : { KernelDispatch::Isa::scalar, KernelDispatch::Isa::baseline,
+                          KernelDispatch::Isa::avx2, KernelDispatch::Isa::avx512 })
+            if (KernelDispatch::getTable (isa) != nullptr)
+                isas.add (isa);
+    }
+
+    juce::Array<Config> configs;
+
+    for (auto sampleRate : sampleRates)
+        for (auto blockSize : blockSizes)
+            for (auto numChannels : channelCounts)
+                for (auto& preset : presets)
+                {
+                    Config config;
+                    config.sampleRate = sampleRate;
+                    config.blockSize = blockSize;
+                    config.numChannels = numChannels;
+                    config.presetName = preset.name;
+                    config.dryWet = preset.dryWet;
+                    config.delayTime = preset.delayTime;
+                    config.feedback = preset.feedback;
+                    config.stereo = preset.stereo;
+                    juce::Array<bool> layouts { false };
+
+                    // Planar and interleaved, float, half-precision and double runs of the
+                    // same setting sit next to each other in the report
+                    if (compareLayouts && numChannels == 2)
+                        layouts.add (true);
+
+                    // A double run always has a double delay line
+                    struct Storage { bool halfPrecision, doublePrecision; };
+                    juce::Array<Storage> storages { Storage { false, false } };
+
+                    if (compareStorage)
+                        storages.add (Storage { true, false });
+
+                    if (comparePrecision)
+                        storages.add (Storage { false, true });
+
+                    juce::Array<int> diffusions { 0 };
+
+                    if (compareDiffusion)
+                        diffusions.addArray ({ 8, 16 });
+
+                    juce::Array<bool> smears { false };
+
+                    if (compareSmear)
+                        smears.add (true);
+
+                    for (auto interleaved : layouts)
+                        for (auto storage : storages)
+                            for (auto diffusionLines : diffusions)
+                                for (auto smear : smears)
+                                    for (auto isa : isas)
+                                    {
+                                        config.interleaved = interleaved;
+                                        config.halfPrecision = storage.halfPrecision;
+                                        config.doublePrecision = storage.doublePrecision;
+                                        config.diffusionLines = diffusionLines;
+                                        config.smear = smear;
+                                        config.isa = isa;
+                                        configs.add (config);
+                                    }
+                }
+
+    return configs;
+}
+
+//==============================================================================
+static void setParameter (FractureAudioProcessor& processor, const juce::String& id, float value)
+{
+    if (auto* parameter = processor.apvts.getParameter (id))
+        parameter->setValueNotifyingHost (parameter->convertTo0to1 (value));
+}
+
+// Returns the time each of numBlocks blocks took, after the warm-up blocks
+template <typename SampleType>
+static std::vector<double> timeBlocks (FractureAudioProcessor& processor, const juce::AudioBuffer<float>& source,
+                                       int blockSize, int warmupBlocks, int numBlocks)
+{
+    auto numChannels = source.getNumChannels();
+    juce::AudioBuffer<SampleType> buffer (numChannels, blockSize);
+    juce::MidiBuffer midi;
+    int sourcePosition = 0;
+
+    auto loadNextBlock = [&]
+    {
+        if (sourcePosition + blockSize > source.getNumSamples())
+            sourcePosition = 0;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* input = source.getReadPointer (channel, sourcePosition);
+            auto* destination = buffer.getWritePointer (channel);
+
+            for (int i = 0; i < blockSize; ++i)
+                destination[i] = static_cast<SampleType> (input[i]);
+        }
+
+        sourcePosition += blockSize;
+    };
+
+    for (int i = 0; i < warmupBlocks; ++i)
+    {
+        loadNextBlock();
+        processor.processBlock (buffer, midi);
+    }
+
+    std::vector<double> blockNanos;
+    blockNanos.reserve (static_cast<size_t> (numBlocks));
+
+    const auto nanosPerTick = 1.0e9 / static_cast<double> (juce::Time::getHighResolutionTicksPerSecond());
+
+    for (int i = 0; i < numBlocks; ++i)
+    {
+        loadNextBlock();
+
+        auto start = juce::Time::getHighResolutionTicks();
+        processor.processBlock (buffer, midi);
+        auto end = juce::Time::getHighResolutionTicks();
+
+        blockNanos.push_back (static_cast<double> (end - start) * nanosPerTick);
+    }
+
+    return blockNanos;
+}
+
+ProcessorBenchmark::Result ProcessorBenchmark::run (const Config& config) const
+{
+    FractureAudioProcessor processor;
+
+    auto channelSet = SpeakerLayout::getDefaultChannelSet (config.numChannels);
+    juce::AudioProcessor::BusesLayout layout;
+    layout.inputBuses.add (channelSet);
+    layout.outputBuses.add (channelSet);
+    processor.setBusesLayout (layout);
+    processor.setDelayLayout (config.interleaved ? DelayLayout::interleaved : DelayLayout::planar);
+    processor.setHalfPrecisionDelay (config.halfPrecision);
+    processor.setKernelIsa (config.isa);
+    processor.setProcessingPrecision (config.doublePrecision ? juce::AudioProcessor::doublePrecision
+                                                             : juce::AudioProcessor::singlePrecision);
+
+    setParameter (processor, "DRYWET", config.dryWet);
+    setParameter (processor, "DELAYTIME", config.delayTime);
+    setParameter (processor, "FEEDBACK", config.feedback);
+    setParameter (processor, "STEREO", config.stereo);
+
+    if (config.diffusionLines > 0)
+    {
+        processor.setDiffusionLines (config.diffusionLines);
+        setParameter (processor, "MODE", static_cast<float> (DelayMode::diffuse));
+    }
+
+    // The blocks aren't paced, so a worker would fall behind; offline, the smear's
+    // large partitions are counted on this thread along with everything else
+    if (config.smear)
+    {
+        processor.setNonRealtime (true);
+        setParameter (processor, "SMEAR", 50.0f);
+        setParameter (processor, "SMEARTIME", 2.0f);
+    }
+
+    processor.setRateAndBufferSizeDetails (config.sampleRate, config.blockSize);
+    processor.prepareToPlay (config.sampleRate, config.blockSize);
+
+    // A second of noise is recycled as input so the timed loop never generates samples
+    juce::AudioBuffer<float> source (config.numChannels, static_cast<int> (config.sampleRate));
+    juce::Random random (0x46726163);
+
+    for (int channel = 0; channel < source.getNumChannels(); ++channel)
+        for (int i = 0; i < source.getNumSamples(); ++i)
+            source.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+    auto numBlocks = juce::jmax (64, static_cast<int> (config.sampleRate * m_options.secondsPerConfig) / config.blockSize);
+    auto blockNanos = config.doublePrecision ? timeBlocks<double> (processor, source, config.blockSize, m_options.warmupBlocks, numBlocks)
+                                             : timeBlocks<float> (processor, source, config.blockSize, m_options.warmupBlocks, numBlocks);
+    auto totalNanos = std::accumulate (blockNanos.begin(), blockNanos.end(), 0.0);
+
+    processor.releaseResources();
+
+    std::sort (blockNanos.begin(), blockNanos.end());
+
+    auto percentile = [&blockNanos] (double p)
+    {
+        auto index = static_cast<size_t> (p * static_cast<double> (blockNanos.size() - 1) + 0.5);
+        return blockNanos[index] / 1000.0;
+    };
+
+    Result result;
+    result.name = config.getName();
+    result.config = config;
+    result.nsPerSample = totalNanos / (static_cast<double> (numBlocks) * config.blockSize);
+    result.p50Micros = percentile (0.50);
+    result.p99Micros = percentile (0.99);
+    result.maxMicros = blockNanos.back() / 1000.0;
+    return result;
+}
+
+juce::Array<ProcessorBenchmark::Result> ProcessorBenchmark::runAll (const juce::Array<Config>& configs) const
+{
+    juce::Array<Result> results;
+
+    std::cout << "Kernels: " << KernelDispatch::getName (KernelDispatch::Isa::automatic) << std::endl << std::endl;
+    std::cout << formatHeader() << std::endl;
+
+    for (auto& config : configs)
+    {
+        auto result = run (config);
+        std::cout << format (result) << std::endl;
+        results.add (result);
+    }
+
+    return results;
+}
+
+//==============================================================================
+juce::String ProcessorBenchmark::formatHeader()
+{
+    return juce::String ("configuration").paddedRight (' ', 60)
+         + juce::String ("ns/sample").paddedLeft (' ', 12)
+         + juce::String ("p50 us").paddedLeft (' ', 12)
+         + juce::String ("p99 us").paddedLeft (' ', 12)
+         + juce::String ("max us").paddedLeft (' ', 12);
+}
+
+juce::String ProcessorBenchmark::format (const Result& result)
+{
+    return result.name.paddedRight (' ', 60)
+         + juce::String (result.nsPerSample, 3).paddedLeft (' ', 12)
+         + juce::String (result.p50Micros, 2).paddedLeft (' ', 12)
+         + juce::String (result.p99Micros, 2).paddedLeft (' ', 12)
+         + juce::String (result.maxMicros, 2).paddedLeft (' ', 12);
+}
+
+void ProcessorBenchmark::printIsaSpeedups (const juce::Array<Result>& results)
+{
+    std::cout << juce::String ("configuration").paddedRight (' ', 60)
+              << juce::String ("scalar").paddedLeft (' ', 12)
+              << juce::String ("ns/sample").paddedLeft (' ', 12)
+              << juce::String ("speed-up").paddedLeft (' ', 12) << std::endl;
+
+    for (auto& result : results)
+    {
+        if (result.config.isa == KernelDispatch::Isa::scalar || result.config.isa == KernelDispatch::Isa::automatic)
+            continue;
+
+        auto scalarConfig = result.config;
+        scalarConfig.isa = KernelDispatch::Isa::scalar;
+        auto scalarName = scalarConfig.getName();
+
+        for (auto& candidate : results)
+        {
+            if (candidate.name == scalarName && result.nsPerSample > 0.0)
+            {
+                std::cout << result.name.paddedRight (' ', 60)
+                          << juce::String (candidate.nsPerSample, 3).paddedLeft (' ', 12)
+                          << juce::String (result.nsPerSample, 3).paddedLeft (' ', 12)
+                          << (juce::String (candidate.nsPerSample / result.nsPerSample, 2) + "x").paddedLeft (' ', 12) << std::endl;
+                break;
+            }
+        }
+    }
+}
+
+void ProcessorBenchmark::printDiffusionCosts (const juce::Array<Result>& results)
+{
+    std::cout << juce::String ("configuration").paddedRight (' ', 60)
+              << juce::String ("single").paddedLeft (' ', 12)
+              << juce::String ("ns/sample").paddedLeft (' ', 12)
+              << juce::String ("cost").paddedLeft (' ', 12) << std::endl;
+
+    for (auto& result : results)
+    {
+        if (result.config.diffusionLines == 0)
+            continue;
+
+        auto singleConfig = result.config;
+        singleConfig.diffusionLines = 0;
+        auto singleName = singleConfig.getName();
+
+        for (auto& candidate : results)
+        {
+            if (candidate.name == singleName && candidate.nsPerSample > 0.0)
+            {
+                std::cout << result.name.paddedRight (' ', 60)
+                          << juce::String (candidate.nsPerSample, 3).paddedLeft (' ', 12)
+                          << juce::String (result.nsPerSample, 3).paddedLeft (' ', 12)
+                          << (juce::String (result.nsPerSample / candidate.nsPerSample, 2) + "x").paddedLeft (' ', 12) << std::endl;
+                break;
+            }
+        }
+    }
+}
+
+bool ProcessorBenchmark::writeCsv (const juce::File& file, const juce::Array<Result>& results)
+{
+    juce::String csv ("configuration,ns_per_sample,p50_us,p99_us,max_us\n");
+
+    for (auto& result : results)
+        csv << result.name << ","
+            << juce::String (result.nsPerSample, 4) << ","
+            << juce::String (result.p50Micros, 3) << ","
+            << juce::String (result.p99Micros, 3) << ","
+            << juce::String (result.maxMicros, 3) << "\n";
+
+    return file.replaceWithText (csv);
+}
+
+juce::Array<ProcessorBenchmark::Result> ProcessorBenchmark::readCsv (const juce::File& file)
+{
+    juce::Array<Result> results;
+    juce::StringArray lines;
+    file.readLines (lines);
+
+    // First line is the column header
+    for (int i = 1; i < lines.size(); ++i)
+    {
+        auto fields = juce::StringArray::fromTokens (lines[i], ",", {});
+
+        if (fields.size() < 5)
+            continue;
+
+        Result result;
+        result.name = fields[0];
+        result.nsPerSample = fields[1].getDoubleValue();
+        result.p50Micros = fields[2].getDoubleValue();
+        result.p99Micros = fields[3].getDoubleValue();
+        result.maxMicros = fields[4].getDoubleValue();
+        results.add (result);
+    }
+
+    return results;
+}
+
+int ProcessorBenchmark::compareWithBaseline (const juce::Array<Result>& results,
+                                             const juce::Array<Result>& baseline,
+                                             double tolerancePercent)
+{
+    int numRegressions = 0;
+
+    std::cout << juce::String ("configuration").paddedRight (' ', 60)
+              << juce::String ("baseline").paddedLeft (' ', 12)
+              << juce::String ("current").paddedLeft (' ', 12)
+              << juce::String ("change").paddedLeft (' ', 12) << std::endl;
+
+    for (auto& result : results)
+    {
+        auto& name = result.name;
+        const Result* reference = nullptr;
+
+        for (auto& candidate : baseline)
+            if (candidate.name == name)
+                reference = &candidate;
+
+        if (reference == nullptr || reference->nsPerSample <= 0.0)
+        {
+            std::cout << name.paddedRight (' ', 60) << juce::String ("-").paddedLeft (' ', 12)
+                      << juce::String (result.nsPerSample, 3).paddedLeft (' ', 12) << "   (new)" << std::endl;
+            continue;
+        }
+
+        auto change = 100.0 * (result.nsPerSample - reference->nsPerSample) / reference->nsPerSample;
+        auto regressed = change > tolerancePercent;
+
+        if (regressed)
+            ++numRegressions;
+
+        std::cout << name.paddedRight (' ', 60)
+                  << juce::String (reference->nsPerSample, 3).paddedLeft (' ', 12)
+                  << juce::String (result.nsPerSample, 3).paddedLeft (' ', 12)
+                  << (juce::String (change, 1) + "%").paddedLeft (' ', 12)
+                  << (regressed ? "   REGRESSION" : "") << std::endl;
+    }
+
+    return numRegressions;
+}
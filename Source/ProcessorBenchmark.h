@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    ProcessorBenchmark.h
+    Created: 18 Oct 2026 10:12:31am
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "KernelDispatch.h"
+
+//==============================================================================
+/**
+    Runs FractureAudioProcessor::processBlock headlessly over a matrix of
+    sample rates, block sizes, channel layouts and parameter settings, and
+    reports the cost of each configuration.
+*/
+class ProcessorBenchmark
+{
+public:
+    struct Config
+    {
+        double sampleRate = 48000.0;
+        int blockSize = 512;
+        int numChannels = 2;
+
+        juce::String presetName = "default";
+        float dryWet = 50.0f;
+        float delayTime = 50.0f;
+        float feedback = 0.2f;
+        float stereo = 0.0f;
+
+        bool interleaved = false;       // frame-interleaved delay line instead of planar (stereo only)
+        bool halfPrecision = false;     // delay line stored as float16
+        bool doublePrecision = false;   // processed through the double-precision processBlock
+        int diffusionLines = 0;         // the diffuse mode with this many lines, or 0 for the single line
+        bool smear = false;             // the wet signal half smeared with a two second impulse response, offline
+        KernelDispatch::Isa isa = KernelDispatch::Isa::automatic;
+
+        // Unique key used to match a result against the stored baseline
+        juce::String getName() const;
+    };
+
+    struct Result
+    {
+        juce::String name;
+        Config config;
+        double nsPerSample = 0.0;
+        double p50Micros = 0.0;
+        double p99Micros = 0.0;
+        double maxMicros = 0.0;
+    };
+
+    struct Options
+    {
+        double secondsPerConfig = 1.0;   // amount of audio rendered per configuration
+        int warmupBlocks = 16;           // blocks processed before timing starts
+        bool quick = false;              // reduced matrix for a fast sanity run
+        bool compareLayouts = false;     // also run every stereo configuration on an interleaved delay line
+        bool compareStorage = false;     // also run every configuration on a half-precision delay line
+        bool compareIsas = false;        // run every configuration with each kernel variant the CPU supports
+        bool comparePrecision = false;   // also run every configuration in double precision
+        bool compareDiffusion = false;   // also run every configuration in the diffuse mode, with 8 and 16 lines
+        bool compareSmear = false;       // also run every configuration with the smear on
+    };
+
+    explicit ProcessorBenchmark (Options options);
+
+    static juce::Array<Config> createMatrix (bool quick, bool compareLayouts = false, bool compareStorage = false,
+                                             bool compareIsas = false, bool comparePrecision = false,
+                                             bool compareDiffusion = false, bool compareSmear = false);
+
+    Result run (const Config& config) const;
+    juce::Array<Result> runAll (const juce::Array<Config>& configs) const;
+
+    //==============================================================================
+    static juce::String formatHeader();
+    static juce::String format (const Result& result);
+
+    /** Prints the speed-up of each variant over the scalar kernels for every configuration run with both. */
+    static void printIsaSpeedups (const juce::Array<Result>& results);
+
+    /** Prints the cost of each diffuse run relative to the same configuration on the single line. */
+    static void printDiffusionCosts (const juce::Array<Result>& results);
+
+    static bool writeCsv (const juce::File& file, const juce::Array<Result>& results);
+    static juce::Array<Result> readCsv (const juce::File& file);
+
+    /** Prints each result next to its baseline and returns the number of
+        configurations whose ns/sample got worse by more than the tolerance.
+    */
+    static int compareWithBaseline (const juce::Array<Result>& results,
+                                    const juce::Array<Result>& baseline,
+                                    double tolerancePercent);
+
+private:
+    Options m_options;
+
+    JUCE_DECLARE_NON_COPYABLE (ProcessorBenchmark)
+};
@@ -0,0 +1,361 @@
+/*
+  ==============================================================================
+
+    RealtimeAudit.cpp
+    Created: 19 Oct 2026 11:02:57am
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#include "RealtimeAudit.h"
+
+#if FRACTURE_REALTIME_AUDIT
+
+#include <cstdlib>
+#include <new>
+
+#if JUCE_LINUX && defined (__GLIBC__)
+ #include <dlfcn.h>
+ #include <pthread.h>
+
+extern "C"
+{
+    void* __libc_malloc (size_t);
+    void* __libc_calloc (size_t, size_t);
+    void* __libc_realloc (void*, size_t);
+    void __libc_free (void*);
+}
+#elif JUCE_WINDOWS
+ #include <windows.h>
+ #include <psapi.h>
+
+ #pragma comment (lib, "psapi.lib")
+#endif
+
+namespace RealtimeAudit
+{
+    namespace
+    {
+        // Plain-initialised thread locals: touching them never allocates
+        thread_local int auditDepth = 0;
+        thread_local bool isReporting = false;
+
+        std::atomic<int> numViolations { 0 };
+        constexpr int maxStoredViolations = 16;
+
+        juce::SpinLock violationLock;
+
+        juce::Array<Violation>& getStoredViolations()
+        {
+            static juce::Array<Violation> violations;
+            return violations;
+        }
+    }
+
+    void check (const char* call) noexcept
+    {
+        if (auditDepth == 0 || isReporting)
+            return;
+
+        // Reporting allocates; the flag keeps that from being reported in turn
+        isReporting = true;
+
+        if (numViolations.fetch_add (1) < maxStoredViolations)
+        {
+            Violation violation { call, juce::SystemStats::getStackBacktrace() };
+
+            const juce::SpinLock::ScopedLockType lock (violationLock);
+            getStoredViolations().add (violation);
+        }
+
+        isReporting = false;
+    }
+
+    //==============================================================================
+    ScopedAudioThread::ScopedAudioThread() noexcept     { ++auditDepth; }
+    ScopedAudioThread::~ScopedAudioThread() noexcept    { --auditDepth; }
+
+    int getNumViolations() noexcept
+    {
+        return numViolations.load();
+    }
+
+    juce::Array<Violation> getViolations()
+    {
+        const juce::SpinLock::ScopedLockType lock (violationLock);
+        return getStoredViolations();
+    }
+
+    void clearViolations()
+    {
+        const juce::SpinLock::ScopedLockType lock (violationLock);
+        getStoredViolations().clear();
+        numViolations = 0;
+    }
+}
+
+//==============================================================================
+#if JUCE_WINDOWS
+/*  Windows has no symbol interposition, so the heap and lock entry points are
+    patched in the import tables of every module loaded when the process
+    starts. Every CRT's malloc and free end in HeapAlloc and HeapFree, and
+    std::mutex and juce::CriticalSection lock through AcquireSRWLockExclusive
+    and EnterCriticalSection, wherever they are linked from. An import is
+    recognised by the address it resolved to, so it is found whichever API
+    set or forwarder it was bound through.
+*/
+namespace
+{
+    using HeapAllocFunction = LPVOID (WINAPI*) (HANDLE, DWORD, SIZE_T);
+    using HeapReAllocFunction = LPVOID (WINAPI*) (HANDLE, DWORD, LPVOID, SIZE_T);
+    using HeapFreeFunction = BOOL (WINAPI*) (HANDLE, DWORD, LPVOID);
+    using EnterCriticalSectionFunction = void (WINAPI*) (LPCRITICAL_SECTION);
+    using AcquireSRWLockFunction = void (WINAPI*) (PSRWLOCK);
+
+    // The originals, resolved before anything is patched
+    HeapAllocFunction realHeapAlloc = nullptr;
+    HeapReAllocFunction realHeapReAlloc = nullptr;
+    HeapFreeFunction realHeapFree = nullptr;
+    EnterCriticalSectionFunction realEnterCriticalSection = nullptr;
+    AcquireSRWLockFunction realAcquireSRWLockExclusive = nullptr;
+
+    LPVOID WINAPI auditedHeapAlloc (HANDLE heap, DWORD flags, SIZE_T size)
+    {
+        RealtimeAudit::check ("HeapAlloc");
+        return realHeapAlloc (heap, flags, size);
+    }
+
+    LPVOID WINAPI auditedHeapReAlloc (HANDLE heap, DWORD flags, LPVOID block, SIZE_T size)
+    {
+        RealtimeAudit::check ("HeapReAlloc");
+        return realHeapReAlloc (heap, flags, block, size);
+    }
+
+    BOOL WINAPI auditedHeapFree (HANDLE heap, DWORD flags, LPVOID block)
+    {
+        if (block != nullptr)
+            RealtimeAudit::check ("HeapFree");
+
+        return realHeapFree (heap, flags, block);
+    }
+
+    void WINAPI auditedEnterCriticalSection (LPCRITICAL_SECTION section)
+    {
+        RealtimeAudit::check ("EnterCriticalSection");
+        realEnterCriticalSection (section);
+    }
+
+    void WINAPI auditedAcquireSRWLockExclusive (PSRWLOCK lock)
+    {
+        RealtimeAudit::check ("AcquireSRWLockExclusive");
+        realAcquireSRWLockExclusive (lock);
+    }
+
+    struct ImportHook
+    {
+        void* original;
+        void* replacement;
+    };
+
+    // Points every import of the module that resolved to a hooked original at its replacement
+    void patchImports (HMODULE module, const ImportHook* hooks, int numHooks)
+    {
+        auto* base = reinterpret_cast<BYTE*> (module);
+        auto* dosHeader = reinterpret_cast<IMAGE_DOS_HEADER*> (base);
+
+        if (dosHeader->e_magic != IMAGE_DOS_SIGNATURE)
+            return;
+
+        auto* ntHeaders = reinterpret_cast<IMAGE_NT_HEADERS*> (base + dosHeader->e_lfanew);
+        auto& directory = ntHeaders->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_IMPORT];
+
+        if (directory.VirtualAddress == 0)
+            return;
+
+        for (auto* descriptor = reinterpret_cast<IMAGE_IMPORT_DESCRIPTOR*> (base + directory.VirtualAddress);
+             descriptor->Name != 0; ++descriptor)
+        {
+            for (auto* thunk = reinterpret_cast<IMAGE_THUNK_DATA*> (base + descriptor->FirstThunk); thunk->u1.Function != 0; ++thunk)
+            {
+                auto** slot = reinterpret_cast<void**> (&thunk->u1.Function);
+
+                for (int i = 0; i < numHooks; ++i)
+                {
+                    if (*slot != hooks[i].original)
+                        continue;
+
+                    DWORD protection;
+
+                    if (VirtualProtect (slot, sizeof (void*), PAGE_READWRITE, &protection))
+                    {
+                        *slot = hooks[i].replacement;
+                        VirtualProtect (slot, sizeof (void*), protection, &protection);
+                    }
+                }
+            }
+        }
+    }
+
+    // Installed while the statics are constructed, before any audio thread exists
+    struct ImportHooks
+    {
+        ImportHooks()
+        {
+            auto* kernel = GetModuleHandleW (L"kernel32.dll");
+
+            realHeapAlloc = reinterpret_cast<HeapAllocFunction> (GetProcAddress (kernel, "HeapAlloc"));
+            realHeapReAlloc = reinterpret_cast<HeapReAllocFunction> (GetProcAddress (kernel, "HeapReAlloc"));
+            realHeapFree = reinterpret_cast<HeapFreeFunction> (GetProcAddress (kernel, "HeapFree"));
+            realEnterCriticalSection = reinterpret_cast<EnterCriticalSectionFunction> (GetProcAddress (kernel, "EnterCriticalSection"));
+            realAcquireSRWLockExclusive = reinterpret_cast<AcquireSRWLockFunction> (GetProcAddress (kernel, "AcquireSRWLockExclusive"));
+
+            const ImportHook hooks[] = {
+                { reinterpret_cast<void*> (realHeapAlloc), reinterpret_cast<void*> (&auditedHeapAlloc) },
+                { reinterpret_cast<void*> (realHeapReAlloc), reinterpret_cast<void*> (&auditedHeapReAlloc) },
+                { reinterpret_cast<void*> (realHeapFree), reinterpret_cast<void*> (&auditedHeapFree) },
+                { reinterpret_cast<void*> (realEnterCriticalSection), reinterpret_cast<void*> (&auditedEnterCriticalSection) },
+                { reinterpret_cast<void*> (realAcquireSRWLockExclusive), reinterpret_cast<void*> (&auditedAcquireSRWLockExclusive) }
+            };
+
+            HMODULE modules[1024];
+            DWORD bytesNeeded = 0;
+
+            if (! EnumProcessModules (GetCurrentProcess(), modules, sizeof (modules), &bytesNeeded))
+                return;
+
+            auto numModules = juce::jmin (static_cast<int> (bytesNeeded / sizeof (HMODULE)), juce::numElementsInArray (modules));
+
+            for (int i = 0; i < numModules; ++i)
+                patchImports (modules[i], hooks, juce::numElementsInArray (hooks));
+        }
+    };
+
+    const ImportHooks importHooks;
+}
+#endif
+
+//==============================================================================
+// Raw allocation that bypasses the malloc hooks, so one new is reported once
+namespace
+{
+   #if JUCE_LINUX && defined (__GLIBC__)
+    void* rawAllocate (size_t size)     { return __libc_malloc (size); }
+    void rawFree (void* block)          { __libc_free (block); }
+   #elif JUCE_WINDOWS
+    // Statics in other files can allocate before the hooks go in, through imports that aren't patched yet
+    void* rawAllocate (size_t size)     { return (realHeapAlloc != nullptr ? realHeapAlloc : &HeapAlloc) (GetProcessHeap(), 0, size); }
+    void rawFree (void* block)          { if (block != nullptr) (realHeapFree != nullptr ? realHeapFree : &HeapFree) (GetProcessHeap(), 0, block); }
+   #else
+    void* rawAllocate (size_t size)     { return std::malloc (size); }
+    void rawFree (void* block)          { std::free (block); }
+   #endif
+
+    void* rawAlignedAllocate (size_t size, size_t alignment)
+    {
+       #if JUCE_WINDOWS
+        // Over-allocated on the process heap, with the block's own address just before the aligned one
+        alignment = juce::jmax (alignment, sizeof (void*));
+        auto* block = static_cast<char*> (rawAllocate (size + alignment + sizeof (void*)));
+
+        if (block == nullptr)
+            return nullptr;
+
+        auto address = (reinterpret_cast<uintptr_t> (block) + sizeof (void*) + alignment - 1) & ~(static_cast<uintptr_t> (alignment) - 1);
+        reinterpret_cast<void**> (address)[-1] = block;
+        return reinterpret_cast<void*> (address);
+       #else
+        void* block = nullptr;
+        return posix_memalign (&block, juce::jmax (alignment, sizeof (void*)), size) == 0 ? block : nullptr;
+       #endif
+    }
+
+    void rawAlignedFree (void* block)
+    {
+       #if JUCE_WINDOWS
+        if (block != nullptr)
+            rawFree (static_cast<void**> (block)[-1]);
+       #else
+        rawFree (block);
+       #endif
+    }
+
+    void* checkedNew (size_t size, const char* call)
+    {
+        RealtimeAudit::check (call);
+
+        if (auto* block = rawAllocate (size > 0 ? size : 1))
+            return block;
+
+        throw std::bad_alloc();
+    }
+
+    void* checkedAlignedNew (size_t size, std::align_val_t alignment, const char* call)
+    {
+        RealtimeAudit::check (call);
+
+        if (auto* block = rawAlignedAllocate (size > 0 ? size : 1, static_cast<size_t> (alignment)))
+            return block;
+
+        throw std::bad_alloc();
+    }
+}
+
+void* operator new (size_t size)                                            { return checkedNew (size, "operator new"); }
+void* operator new[] (size_t size)                                          { return checkedNew (size, "operator new[]"); }
+void* operator new (size_t size, const std::nothrow_t&) noexcept            { RealtimeAudit::check ("operator new"); return rawAllocate (size > 0 ? size : 1); }
+void* operator new[] (size_t size, const std::nothrow_t&) noexcept          { RealtimeAudit::check ("operator new[]"); return rawAllocate (size > 0 ? size : 1); }
+void* operator new (size_t size, std::align_val_t alignment)                { return checkedAlignedNew (size, alignment, "operator new"); }
+void* operator new[] (size_t size, std::align_val_t alignment)              { return checkedAlignedNew (size, alignment, "operator new[]"); }
+
+void operator delete (void* block) noexcept                                 { if (block != nullptr) RealtimeAudit::check ("operator delete"); rawFree (block); }
+void operator delete[] (void* block) noexcept                               { if (block != nullptr) RealtimeAudit::check ("operator delete[]"); rawFree (block); }
+void operator delete (void* block, size_t) noexcept                         { operator delete (block); }
+void operator delete[] (void* block, size_t) noexcept                       { operator delete[] (block); }
+void operator delete (void* block, std::align_val_t) noexcept               { if (block != nullptr) RealtimeAudit::check ("operator delete"); rawAlignedFree (block); }
+void operator delete[] (void* block, std::align_val_t) noexcept             { if (block != nullptr) RealtimeAudit::check ("operator delete[]"); rawAlignedFree (block); }
+void operator delete (void* block, size_t, std::align_val_t alignment) noexcept     { operator delete (block, alignment); }
+void operator delete[] (void* block, size_t, std::align_val_t alignment) noexcept   { operator delete[] (block, alignment); }
+
+//==============================================================================
+#if JUCE_LINUX && defined (__GLIBC__)
+extern "C"
+{
+    void* malloc (size_t size)                  { RealtimeAudit::check ("malloc"); return __libc_malloc (size); }
+    void* calloc (size_t count, size_t size)    { RealtimeAudit::check ("calloc"); return __libc_calloc (count, size); }
+    void* realloc (void* block, size_t size)    { RealtimeAudit::check ("realloc"); return __libc_realloc (block, size); }
+    void free (void* block)                     { if (block != nullptr) RealtimeAudit::check ("free"); __libc_free (block); }
+
+    int pthread_mutex_lock (pthread_mutex_t* mutex)
+    {
+        using LockFunction = int (*) (pthread_mutex_t*);
+
+        // Resolved without a function-local static: its guard could take this very lock
+        static std::atomic<LockFunction> realLock { nullptr };
+        auto lock = realLock.load (std::memory_order_acquire);
+
+        if (lock == nullptr)
+        {
+            lock = reinterpret_cast<LockFunction> (dlsym (RTLD_NEXT, "pthread_mutex_lock"));
+            realLock.store (lock, std::memory_order_release);
+        }
+
+        RealtimeAudit::check ("pthread_mutex_lock");
+        return lock (mutex);
+    }
+}
+#endif
+
+#else
+
+namespace RealtimeAudit
+{
+    ScopedAudioThread::ScopedAudioThread() noexcept {}
+    ScopedAudioThread::~ScopedAudioThread() noexcept {}
+
+    int getNumViolations() noexcept             { return 0; }
+    juce::Array<Violation> getViolations()      { return {}; }
+    void clearViolations()                      {}
+}
+
+#endif
@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    RealtimeAudit.h
+    Created: 19 Oct 2026 11:02:57am
+    Author:  97252
+
+    Audio-thread instrumentation for audit builds. With FRACTURE_REALTIME_AUDIT=1
+    the global operator new/delete are replaced. On Linux malloc/free and
+    pthread_mutex_lock are interposed; on Windows HeapAlloc/HeapReAlloc/HeapFree,
+    EnterCriticalSection and AcquireSRWLockExclusive are patched in the import
+    tables of every module loaded at startup. Any of them called on a thread
+    that is inside a ScopedAudioThread is recorded as a violation with a stack
+    trace.
+
+    Without the flag everything here compiles to nothing.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef FRACTURE_REALTIME_AUDIT
+ #define FRACTURE_REALTIME_AUDIT 0
+#endif
+
+namespace RealtimeAudit
+{
+    /** True when this build contains the hooks. */
+    constexpr bool isAvailable() noexcept   { return FRACTURE_REALTIME_AUDIT != 0; }
+
+    /** Marks the calling thread as the audio thread for the lifetime of the object. */
+    class ScopedAudioThread
+    {
+    public:
+        ScopedAudioThread() noexcept;
+        ~ScopedAudioThread() noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedAudioThread)
+    };
+
+    struct Violation
+    {
+        juce::String call;
+        juce::String stackTrace;
+    };
+
+    int getNumViolations() noexcept;
+
+    /** The first few violations since the last clear, with their stack traces. */
+    juce::Array<Violation> getViolations();
+
+    void clearViolations();
+}
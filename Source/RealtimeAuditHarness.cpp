@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+    RealtimeAuditHarness.cpp
+    Created: 19 Oct 2026 11:48:20am
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#include "RealtimeAuditHarness.h"
+#include "RealtimeAudit.h"
+#include "PluginProcessor.h"
+#include "ParameterEngine.h"
+#include "SpeakerLayout.h"
+
+#include <iostream>
+
+//==============================================================================
+static void setParameter (FractureAudioProcessor& processor, const juce::String& id, float value)
+{
+    if (auto* parameter = processor.apvts.getParameter (id))
+        parameter->setValueNotifyingHost (parameter->convertTo0to1 (value));
+}
+
+// Runs one run's blocks in the given precision. Returns the block that broke the
+// rules and how long it was, or -1 if every block was clean
+template <typename SampleType>
+static int auditBlocks (FractureAudioProcessor& processor, juce::Random& random, int numChannels, int maxBlockSize,
+                        int numBlocks, const juce::MemoryBlock* states, int& numSamples)
+{
+    juce::AudioBuffer<SampleType> buffer (numChannels, maxBlockSize);
+    juce::MidiBuffer midi;
+    auto& parameters = processor.getParameters();
+
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        // Parameter changes arrive from other threads, so they are made outside the audit scope
+        for (int change = random.nextInt (3); --change >= 0;)
+            parameters[random.nextInt (parameters.size())]->setValueNotifyingHost (random.nextFloat());
+
+        // Into Diffuse and back out, which fades the wet and clears the lines on the way
+        if (block % 60 == 30)
+        {
+            auto mode = static_cast<DelayMode> (juce::roundToInt (processor.apvts.getRawParameterValue ("MODE")->load()));
+            auto next = mode == DelayMode::diffuse ? static_cast<DelayMode> (random.nextInt (2)) : DelayMode::diffuse;
+            setParameter (processor, "MODE", static_cast<float> (next));
+        }
+
+        // A live recall: the fade and the jump of the ramps happen in the audited blocks, and
+        // the message thread's part in the timer callbacks run between them
+        if (block % 100 == 70)
+        {
+            auto& state = states[(block / 100) % 2];
+            processor.setStateInformation (state.getData(), static_cast<int> (state.getSize()));
+        }
+
+        juce::Timer::callPendingTimersSynchronously();
+
+        // Stretches of silence let the idle detector put the processor to sleep and wake it again
+        auto silent = (block / 50) % 3 == 2;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < maxBlockSize; ++i)
+                buffer.setSample (channel, i, silent ? SampleType() : static_cast<SampleType> (random.nextFloat() * 2.0f - 1.0f));
+
+        numSamples = 1 + random.nextInt (maxBlockSize);
+        juce::AudioBuffer<SampleType> view (buffer.getArrayOfWritePointers(), numChannels, numSamples);
+
+        {
+            RealtimeAudit::ScopedAudioThread audioThread;
+            processor.processBlock (view, midi);
+        }
+
+        if (RealtimeAudit::getNumViolations() > 0)
+            return block;
+    }
+
+    return -1;
+}
+
+//==============================================================================
+RealtimeAuditHarness::RealtimeAuditHarness (Options options)
+    : m_options (options)
+{
+}
+
+bool RealtimeAuditHarness::run()
+{
+    const double sampleRates[] = { 22050.0, 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+    const int maxBlockSizes[] = { 1, 16, 32, 64, 128, 441, 512, 1024, 4096 };
+    const int channelCounts[] = { 1, 2, 4, 6, 8, 9, 12, 16 };
+
+    juce::Random random (m_options.seed);
+    FractureAudioProcessor processor;
+    auto& parameters = processor.getParameters();
+
+    RealtimeAudit::clearViolations();
+
+    for (int run = 0; run < m_options.numRuns; ++run)
+    {
+        // Preparing is allowed to allocate: it happens before the audio thread starts
+        auto sampleRate = sampleRates[random.nextInt (juce::numElementsInArray (sampleRates))];
+        auto maxBlockSize = maxBlockSizes[random.nextInt (juce::numElementsInArray (maxBlockSizes))];
+        auto numChannels = channelCounts[random.nextInt (juce::numElementsInArray (channelCounts))];
+        auto isDouble = random.nextBool();
+        auto channelSet = SpeakerLayout::getDefaultChannelSet (numChannels);
+
+        juce::AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add (channelSet);
+        layout.outputBuses.add (channelSet);
+
+        // Two random states for the recalls during the run, saved with the parameters set from outside
+        juce::MemoryBlock states[2];
+
+        for (auto& state : states)
+        {
+            for (auto* parameter : parameters)
+                parameter->setValueNotifyingHost (random.nextFloat());
+
+            processor.getStateInformation (state);
+        }
+
+        // Half the runs start with the smear up, so its worker is started and fed from the audio thread
+        if (random.nextBool())
+        {
+            setParameter (processor, "SMEAR", 20.0f + 80.0f * random.nextFloat());
+            setParameter (processor, "SMEARTIME", 0.5f + 3.5f * random.nextFloat());
+        }
+        else
+        {
+            setParameter (processor, "SMEAR", 0.0f);
+        }
+
+        processor.releaseResources();
+        processor.setBusesLayout (layout);
+        processor.setProcessingPrecision (isDouble ? juce::AudioProcessor::doublePrecision : juce::AudioProcessor::singlePrecision);
+        processor.setRateAndBufferSizeDetails (sampleRate, maxBlockSize);
+        processor.prepareToPlay (sampleRate, maxBlockSize);
+
+        int numSamples = 0;
+        auto failedBlock = isDouble ? auditBlocks<double> (processor, random, numChannels, maxBlockSize, m_options.blocksPerRun, states, numSamples)
+                                    : auditBlocks<float> (processor, random, numChannels, maxBlockSize, m_options.blocksPerRun, states, numSamples);
+        auto precision = isDouble ? "double" : "float";
+
+        if (failedBlock >= 0)
+        {
+            std::cout << "Violation in run " << run << ", block " << failedBlock << ": "
+                      << sampleRate << " Hz, " << numChannels << " ch, " << precision << ", "
+                      << numSamples << " of max " << maxBlockSize << " samples" << std::endl;
+
+            for (auto& parameter : parameters)
+                std::cout << "  " << parameter->getName (32) << " = " << parameter->getCurrentValueAsText() << std::endl;
+
+            for (auto& violation : RealtimeAudit::getViolations())
+                std::cout << std::endl << violation.call << " on the audio thread:" << std::endl
+                          << violation.stackTrace << std::endl;
+
+            return false;
+        }
+
+        std::cout << "run " << run << ": " << sampleRate << " Hz, " << numChannels << " ch, " << precision
+                  << ", max block " << maxBlockSize << " - clean" << std::endl;
+    }
+
+    return true;
+}
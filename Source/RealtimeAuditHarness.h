@@ -0,0 +1,49 @@
+/*
+  ==============================================================================
+
+    RealtimeAuditHarness.h
+    Created: 19 Oct 2026 11:48:20am
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Drives FractureAudioProcessor through randomised layouts, sample rates,
+    block sizes, parameter sweeps and silences, with every processBlock call
+    inside a RealtimeAudit::ScopedAudioThread. Anything that allocates or
+    locks on the audio thread is reported with its stack trace.
+
+    Runs pick float or double processing at random, and half of them turn
+    the smear up so its worker is woken and handed partitions. Every run
+    switches MODE into Diffuse and back, and recalls saved states with
+    setStateInformation while it plays, pumping the timers between blocks
+    the way the message thread would.
+
+    Needs a build with FRACTURE_REALTIME_AUDIT=1 (the Audit configuration).
+*/
+class RealtimeAuditHarness
+{
+public:
+    struct Options
+    {
+        int numRuns = 40;           // each run re-prepares with a random layout and sample rate
+        int blocksPerRun = 500;
+        juce::int64 seed = 1;
+    };
+
+    explicit RealtimeAuditHarness (Options options);
+
+    /** Returns true if no violation was recorded. */
+    bool run();
+
+private:
+    Options m_options;
+
+    JUCE_DECLARE_NON_COPYABLE (RealtimeAuditHarness)
+};
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    SignalTelemetry.cpp
+    Created: 21 Oct 2026 9:40:12am
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#include "SignalTelemetry.h"
+
+//==============================================================================
+void SignalTelemetry::prepare (double sampleRate, double maxDelayMs)
+{
+    m_samplesPerMs = sampleRate / 1000.0;
+
+    // Far enough back for the last echo on screen at the longest delay
+    auto reach = maxDelayMs * m_samplesPerMs * (TelemetryFrame::numEchoes - 2);
+    m_history.assign (static_cast<size_t> (std::ceil (reach / hopSize)) + 2, 0.0f);
+    m_historyPosition = 0;
+    m_hopFill = 0;
+
+    m_delayed.reset();
+    std::fill (std::begin (m_tapPeaks), std::end (m_tapPeaks), 0.0f);
+    std::fill (std::begin (m_hopTapLevels), std::end (m_hopTapLevels), 0.0f);
+    m_feedbackEnergy = 0.0f;
+
+    m_bus.publish ({});
+}
+
+void SignalTelemetry::addTaps (const LevelMeter& sum, const float* tapPeaks, int numTaps) noexcept
+{
+    m_delayed.add (sum);
+
+    for (int tap = 0; tap < juce::jmin (numTaps, TelemetryFrame::numEchoes - 1); ++tap)
+        m_tapPeaks[tap] = juce::jmax (m_tapPeaks[tap], tapPeaks[tap]);
+}
+
+void SignalTelemetry::update (float inputPeak, float outputPeak, const ParameterSnapshot& parameters, int numSamples) noexcept
+{
+    if (m_history.empty())
+        return;
+
+    // A hop ends with its levels latched for the frames that follow. A block longer
+    // than a hop gives its peak to every hop it completes
+    m_hopFill += numSamples;
+
+    if (m_hopFill >= hopSize)
+    {
+        for (; m_hopFill >= hopSize; m_hopFill -= hopSize)
+        {
+            m_history[static_cast<size_t> (m_historyPosition)] = m_delayed.peak;
+            m_historyPosition = (m_historyPosition + 1) % static_cast<int> (m_history.size());
+        }
+
+        m_feedbackEnergy = m_delayed.getMeanSquare();
+        std::copy (std::begin (m_tapPeaks), std::end (m_tapPeaks), std::begin (m_hopTapLevels));
+
+        m_delayed.reset();
+        std::fill (std::begin (m_tapPeaks), std::end (m_tapPeaks), 0.0f);
+    }
+
+    TelemetryFrame frame;
+    frame.inputPeak = inputPeak;
+    frame.outputPeak = outputPeak;
+    frame.feedbackEnergy = m_feedbackEnergy;
+    frame.echoLevels[0] = inputPeak;
+
+    if (parameters.mode == DelayMode::multiTap)
+    {
+        for (int echo = 1; echo < TelemetryFrame::numEchoes; ++echo)
+            frame.echoLevels[echo] = m_hopTapLevels[echo - 1];
+    }
+    else if (parameters.mode == DelayMode::single)
+    {
+        auto delayHops = juce::jmax (1.0, parameters.delayTimeMs * m_samplesPerMs / hopSize);
+
+        for (int echo = 1; echo < TelemetryFrame::numEchoes; ++echo)
+        {
+            auto hopsAgo = juce::roundToInt ((echo - 1) * delayHops);
+
+            if (hopsAgo >= static_cast<int> (m_history.size()) - 1)
+                break;
+
+            frame.echoLevels[echo] = getHistoryPeak (hopsAgo);
+        }
+    }
+
+    m_bus.publish (frame);
+}
+
+float SignalTelemetry::getHistoryPeak (int hopsAgo) const noexcept
+{
+    auto size = static_cast<int> (m_history.size());
+    return m_history[static_cast<size_t> ((m_historyPosition - 1 - hopsAgo + 2 * size) % size)];
+}
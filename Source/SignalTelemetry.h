@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    SignalTelemetry.h
+    Created: 21 Oct 2026 9:40:12am
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ParameterEngine.h"
+#include "TelemetryBus.h"
+
+//==============================================================================
+/**
+    Audio-thread side of the visualiser: meters what the delay actually
+    returns and publishes it as a TelemetryFrame on a TelemetryBus.
+
+    The processor hands over the delayed signal as it is made: the read
+    heads' output after the tone filter, or each tap of the multi-tap and the
+    taps' sum. Those levels are decimated to one peak and one mean square per
+    hopSize samples, so a frame shows the last whole hop.
+
+    A recirculating line's repeats all come out of the same read head, so
+    they can't be metered apart. The single line's echoes are drawn from a
+    history of its measured output instead: echo n is the level that came out
+    n - 1 delay times ago. The multi-tap draws each tap's own level. The
+    diffuse network is not metered, so it gets no echo levels.
+*/
+class SignalTelemetry
+{
+public:
+    static constexpr int hopSize = 256;
+
+    SignalTelemetry() = default;
+
+    /** Sizes the envelope history for delays of up to maxDelayMs. Not real-time safe. */
+    void prepare (double sampleRate, double maxDelayMs);
+
+    /** Meters one channel of what the read heads returned. Audio thread only. */
+    template <typename SampleType>
+    void addDelayed (const SampleType* delayed, int numSamples) noexcept   { m_delayed.add (delayed, numSamples); }
+
+    /** addDelayed for numSamples laned frames holding numChannels channels; the spare lanes are silent. */
+    template <typename SampleType>
+    void addDelayedFrames (const SampleType* frames, int numSamples, int numChannels) noexcept
+    {
+        m_delayed.add (frames, numSamples * DelayKernels::channelLanes);
+        m_delayed.numSamples -= numSamples * (DelayKernels::channelLanes - numChannels);
+    }
+
+    /** Takes the multi-tap's meters: the taps' sum and each tap's peak. Audio thread only. */
+    void addTaps (const LevelMeter& sum, const float* tapPeaks, int numTaps) noexcept;
+
+    /** Records a block's input and output peaks and publishes a frame with
+        whatever was metered since the last one. Wait-free, audio thread only.
+    */
+    void update (float inputPeak, float outputPeak, const ParameterSnapshot& parameters, int numSamples) noexcept;
+
+    const TelemetryBus& getBus() const noexcept      { return m_bus; }
+
+private:
+    float getHistoryPeak (int hopsAgo) const noexcept;
+
+    TelemetryBus m_bus;
+
+    // What the current hop has metered so far, and what the last whole one ended with
+    LevelMeter m_delayed;
+    float m_tapPeaks[TelemetryFrame::numEchoes - 1] = {};
+    float m_hopTapLevels[TelemetryFrame::numEchoes - 1] = {};
+    float m_feedbackEnergy = 0.0f;
+
+    std::vector<float> m_history;           // one delayed-signal peak per hop, m_historyPosition is the next to write
+    int m_historyPosition = 0;
+    int m_hopFill = 0;
+    double m_samplesPerMs = 44.1;
+
+    JUCE_DECLARE_NON_COPYABLE (SignalTelemetry)
+};
@@ -0,0 +1,887 @@
+/*
+  ==============================================================================
+
+    SmearConvolver.cpp
+    Created: 23 Oct 2026 4:37:12pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#include "SmearConvolver.h"
+
+namespace
+{
+    struct StageLayout
+    {
+        int blockSize, start, end;
+        bool isBackground;
+    };
+
+    // Each stage starts one block in when it runs at once, and three when it runs on the worker
+    constexpr StageLayout stageLayouts[] =
+    {
+        { 64,   64,    1536,                                false },
+        { 512,  1536,  6144,                                true },
+        { 2048, 6144,  24576,                               true },
+        { 8192, 24576, std::numeric_limits<int>::max(),     true }
+    };
+
+    constexpr int ringLength = 16384;           // two of the largest blocks
+    constexpr double fadeSeconds = 0.01;
+}
+
+//==============================================================================
+SmearConvolver::SmearConvolver (juce::AudioProcessorValueTreeState& apvts)
+    : juce::Thread ("Fracture smear"),
+      m_apvts (apvts),
+      m_amount (apvts.getRawParameterValue ("SMEAR")),
+      m_decay (apvts.getRawParameterValue ("SMEARTIME"))
+{
+    jassert (m_amount != nullptr && m_decay != nullptr);
+    static_assert (stageLayouts[0].blockSize == headLength && stageLayouts[0].start == headLength, "the head ends where the stages begin");
+
+    for (int index = 0; index < numStages; ++index)
+    {
+        auto& layout = stageLayouts[index];
+        auto& stage = m_stages[index];
+        auto order = juce::roundToInt (std::log2 (2 * layout.blockSize));
+
+        stage.index = index;
+        stage.blockSize = layout.blockSize;
+        stage.start = layout.start;
+        stage.end = layout.end;
+        stage.isBackground = layout.isBackground;
+
+        // The builder has its own transforms, so it never contends with a task
+        stage.fft = std::make_unique<juce::dsp::FFT> (order);
+        m_buildFfts[index] = std::make_unique<juce::dsp::FFT> (order);
+    }
+
+    m_apvts.addParameterListener ("SMEAR", this);
+    m_apvts.addParameterListener ("SMEARTIME", this);
+}
+
+SmearConvolver::~SmearConvolver()
+{
+    m_apvts.removeParameterListener ("SMEAR", this);
+    m_apvts.removeParameterListener ("SMEARTIME", this);
+    cancelPendingUpdate();
+
+    stopWorker();
+
+    delete m_current;
+    delete m_pending.exchange (nullptr);
+    delete m_retired.exchange (nullptr);
+}
+
+//==============================================================================
+juce::Result SmearConvolver::loadImpulseResponse (const juce::File& file)
+{
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader (formats.createReaderFor (file));
+
+    if (reader == nullptr || reader->sampleRate <= 0.0 || reader->lengthInSamples <= 0 || reader->numChannels == 0)
+        return juce::Result::fail ("Could not read an impulse response from " + file.getFullPathName());
+
+    auto length = static_cast<int> (juce::jmin (reader->lengthInSamples,
+                                                static_cast<juce::int64> (std::ceil (maxImpulseSeconds * reader->sampleRate))));
+
+    juce::AudioBuffer<float> impulse (juce::jmin (static_cast<int> (reader->numChannels), maxImpulseChannels), length);
+
+    if (! reader->read (&impulse, 0, length, 0, true, true))
+        return juce::Result::fail ("Could not read an impulse response from " + file.getFullPathName());
+
+    setImpulseResponse (impulse, reader->sampleRate, file);
+    return juce::Result::ok();
+}
+
+void SmearConvolver::setImpulseResponse (const juce::AudioBuffer<float>& impulse, double sampleRate, const juce::File& file)
+{
+    if (impulse.getNumSamples() == 0 || impulse.getNumChannels() == 0 || sampleRate <= 0.0)
+    {
+        clearImpulseResponse();
+        return;
+    }
+
+    auto length = juce::jmin (impulse.getNumSamples(), static_cast<int> (std::ceil (maxImpulseSeconds * sampleRate)));
+    auto numChannels = juce::jmin (impulse.getNumChannels(), maxImpulseChannels);
+
+    {
+        const juce::ScopedLock lock (m_sourceLock);
+        m_source.setSize (numChannels, length);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            m_source.copyFrom (channel, 0, impulse, channel, 0, length);
+
+        m_sourceRate = sampleRate;
+        m_sourceFile = file;
+        m_hasSource = true;
+        ++m_sourceVersion;
+    }
+
+    wake();
+    startWorkerIfNeeded();
+}
+
+void SmearConvolver::clearImpulseResponse()
+{
+    const juce::ScopedLock lock (m_sourceLock);
+
+    if (! m_hasSource)
+        return;
+
+    m_source.setSize (0, 0);
+    m_sourceFile = juce::File();
+    m_hasSource = false;
+    ++m_sourceVersion;
+
+    wake();
+}
+
+juce::File SmearConvolver::getImpulseFile() const
+{
+    const juce::ScopedLock lock (m_sourceLock);
+    return m_sourceFile;
+}
+
+double SmearConvolver::getImpulseSeconds() const
+{
+    const juce::ScopedLock lock (m_sourceLock);
+
+    if (m_hasSource)
+        return m_source.getNumSamples() / m_sourceRate;
+
+    return juce::jmin (maxImpulseSeconds, static_cast<double> (m_decay->load()));
+}
+
+//==============================================================================
+void SmearConvolver::prepare (double sampleRate, int numChannels, int maxSpanSize, bool isRealtime,
+                              const KernelDispatch::Table& kernels)
+{
+    // With the worker stopped nothing is in flight, so everything can be rebuilt here
+    stopWorker();
+
+    m_sampleRate = sampleRate;
+    m_numChannels = juce::jmax (1, numChannels);
+    m_isRealtime = isRealtime;
+    m_kernels = &kernels;
+    m_maxLength = static_cast<int> (std::ceil (maxImpulseSeconds * sampleRate));
+
+    delete m_pending.exchange (nullptr);
+    delete m_retired.exchange (nullptr);
+
+    for (auto& stage : m_stages)
+    {
+        auto fftSize = 2 * stage.blockSize;
+
+        stage.maxPartitions = getNumPartitions (stage, m_maxLength);
+        stage.history.setSize (m_numChannels * stage.maxPartitions, fftSize + 2);
+        stage.nextSlot = 0;
+        stage.numFilled = 0;
+        stage.lastGeneration = -1;
+        stage.work.setSize (2, 2 * fftSize);
+        stage.output.setSize (m_numChannels, stage.blockSize);
+
+        for (auto& task : stage.tasks)
+        {
+            task.window.setSize (m_numChannels, fftSize);
+            task.result.setSize (m_numChannels, stage.blockSize);
+            task.generation = -1;
+            task.state = idle;
+        }
+    }
+
+    m_ring.setSize (m_numChannels, ringLength);
+    m_recent.setSize (m_numChannels, 2 * headLength);
+    m_wet.setSize (m_numChannels, maxSpanSize);
+    m_convolved.setSize (m_numChannels, maxSpanSize);
+    m_gain.setSize (1, maxSpanSize);
+
+    m_fade.reset (sampleRate, fadeSeconds);
+    m_fade.setCurrentAndTargetValue (1.0f);
+
+    m_built = getSettings();
+    delete m_current;
+    m_current = build (m_built).release();
+
+    reset();
+    m_needsReset = false;
+    m_isActive = false;
+
+    startWorkerIfNeeded();
+}
+
+void SmearConvolver::setRealtime (bool isRealtime)
+{
+    if (isRealtime == m_isRealtime.load())
+        return;
+
+    if (isRealtime)
+    {
+        {
+            const juce::ScopedLock sl (m_offlineLock);
+            m_isRealtime = true;
+        }
+
+        startWorkerIfNeeded();
+    }
+    else
+    {
+        // The worker has to be gone before the audio thread runs the tasks; any it
+        // left queued are dropped when they fall due
+        stopWorker();
+        m_isRealtime = false;
+    }
+}
+
+void SmearConvolver::update()
+{
+    if (m_isRealtime.load())
+        return;
+
+    // The caller is the only thread, so the new impulse response is swapped in on the next capture()
+    const juce::ScopedLock sl (m_offlineLock);
+    auto settings = getSettings();
+
+    if (! m_isRealtime.load() && settings != m_built)
+    {
+        m_built = settings;
+        publish (build (settings));
+    }
+}
+
+//==============================================================================
+void SmearConvolver::startWorkerIfNeeded()
+{
+    // Only once prepared, and the first time the smear is wanted
+    if (m_kernels != nullptr && m_isRealtime.load() && ! isThreadRunning()
+        && (m_amount->load() > 0.0f || m_hasSource.load()))
+        startThread (juce::Thread::Priority::high);
+}
+
+void SmearConvolver::stopWorker()
+{
+    signalThreadShouldExit();
+    wake();
+    stopThread (1000);
+}
+
+void SmearConvolver::wake() noexcept
+{
+    if (! m_wakePending.exchange (true))
+        m_wake.release();
+}
+
+void SmearConvolver::parameterChanged (const juce::String& parameterID, float newValue)
+{
+    // Hosts can move parameters on the audio thread, so the worker is started from the message thread
+    if (parameterID == "SMEARTIME")
+        wake();
+    else if (newValue > 0.0f && ! isThreadRunning())
+        triggerAsyncUpdate();
+}
+
+void SmearConvolver::handleAsyncUpdate()
+{
+    startWorkerIfNeeded();
+}
+
+void SmearConvolver::run()
+{
+    while (! threadShouldExit())
+    {
+        serviceTasks (numStages);
+        delete m_retired.exchange (nullptr);
+
+        auto settings = getSettings();
+
+        if (settings != m_built)
+        {
+            m_built = settings;
+            publish (build (settings));
+            continue;
+        }
+
+        // Until the audio thread hands over a block or an impulse response, or the settings move.
+        // Exchanging the flag, rather than storing it, sees every task queued before the wake
+        m_wake.acquire();
+        m_wakePending.exchange (false);
+    }
+}
+
+bool SmearConvolver::serviceTasks (int numStagesToService) noexcept
+{
+    auto didWork = false;
+    auto generation = m_generation.load();
+
+    // Shorter blocks are due sooner, so they go first, and each stage's in the order they came
+    for (int index = 0; index < numStagesToService; ++index)
+    {
+        auto& stage = m_stages[index];
+
+        if (! stage.isBackground)
+            continue;
+
+        for (;;)
+        {
+            Task* next = nullptr;
+
+            for (auto& task : stage.tasks)
+                if (task.state.load (std::memory_order_acquire) == queued && (next == nullptr || task.block < next->block))
+                    next = &task;
+
+            if (next == nullptr)
+                break;
+
+            int expected = queued;
+
+            if (! next->state.compare_exchange_strong (expected, running, std::memory_order_acquire))
+                continue;       // taken back by the audio thread
+
+            // The history needs them in order, and the earlier one may only just have shown up
+            auto& other = stage.tasks[&stage.tasks[0] == next ? 1 : 0];
+
+            if (other.state.load (std::memory_order_acquire) == queued && other.block < next->block)
+            {
+                next->state.store (queued, std::memory_order_release);
+                continue;
+            }
+
+            // A task from before a reset may point at an impulse response on its way out
+            if (next->generation == generation)
+                runTask (stage, *next, true);
+
+            next->state.store (done, std::memory_order_release);
+            didWork = true;
+        }
+    }
+
+    return didWork;
+}
+
+SmearConvolver::Settings SmearConvolver::getSettings() const
+{
+    Settings settings;
+    settings.sampleRate = m_sampleRate;
+    settings.decaySeconds = m_hasSource ? 0.0f : m_decay->load (std::memory_order_relaxed);
+    settings.sourceVersion = m_sourceVersion.load();
+    return settings;
+}
+
+std::unique_ptr<SmearConvolver::Impulse> SmearConvolver::build (const Settings& settings)
+{
+    auto response = makeResponse (settings);
+    auto impulse = std::make_unique<Impulse>();
+    impulse->length = response.getNumSamples();
+    impulse->numChannels = response.getNumChannels();
+
+    impulse->head.setSize (impulse->numChannels, headLength);
+    impulse->head.clear();
+
+    for (int channel = 0; channel < impulse->numChannels; ++channel)
+        impulse->head.copyFrom (channel, 0, response, channel, 0, juce::jmin (headLength, impulse->length));
+
+    std::vector<float> transform;
+
+    for (auto& stage : m_stages)
+    {
+        auto fftSize = 2 * stage.blockSize;
+        auto numPartitions = getNumPartitions (stage, impulse->length);
+        auto& spectra = impulse->spectra[stage.index];
+
+        impulse->numPartitions[stage.index] = numPartitions;
+        spectra.setSize (impulse->numChannels * numPartitions, fftSize + 2);
+        transform.resize (static_cast<size_t> (2 * fftSize));
+
+        for (int channel = 0; channel < impulse->numChannels; ++channel)
+        {
+            for (int partition = 0; partition < numPartitions; ++partition)
+            {
+                auto first = stage.start + partition * stage.blockSize;
+                auto numTaps = juce::jmin (stage.blockSize, impulse->length - first);
+
+                std::fill (transform.begin(), transform.end(), 0.0f);
+                juce::FloatVectorOperations::copy (transform.data(), response.getReadPointer (channel, first), numTaps);
+                m_buildFfts[stage.index]->performRealOnlyForwardTransform (transform.data(), true);
+                juce::FloatVectorOperations::copy (spectra.getWritePointer (channel * numPartitions + partition), transform.data(), fftSize + 2);
+
+                // A long build mustn't hold up the blocks falling due
+                serviceTasks (numStages);
+            }
+        }
+    }
+
+    return impulse;
+}
+
+juce::AudioBuffer<float> SmearConvolver::makeResponse (const Settings& settings) const
+{
+    juce::AudioBuffer<float> response;
+
+    if (settings.decaySeconds <= 0.0f)
+    {
+        const juce::ScopedLock lock (m_sourceLock);
+
+        if (m_source.getNumSamples() > 0)
+        {
+            auto ratio = m_sourceRate / settings.sampleRate;
+            auto length = juce::jlimit (1, m_maxLength, static_cast<int> (std::ceil (m_source.getNumSamples() / ratio)));
+            response.setSize (m_source.getNumChannels(), length);
+
+            // The interpolator reads a little past the last sample it is asked for
+            juce::AudioBuffer<float> padded (m_source.getNumChannels(), m_source.getNumSamples() + static_cast<int> (std::ceil (ratio)) + 8);
+            padded.clear();
+
+            for (int channel = 0; channel < m_source.getNumChannels(); ++channel)
+            {
+                padded.copyFrom (channel, 0, m_source, channel, 0, m_source.getNumSamples());
+
+                juce::LagrangeInterpolator interpolator;
+                interpolator.process (ratio, padded.getReadPointer (channel), response.getWritePointer (channel), length);
+            }
+        }
+    }
+
+    // Decorrelated noise per side, falling by 60 dB over its length
+    if (response.getNumSamples() == 0)
+    {
+        auto seconds = settings.decaySeconds > 0.0f ? settings.decaySeconds : m_decay->load (std::memory_order_relaxed);
+        auto length = juce::jlimit (headLength, juce::jmax (headLength, m_maxLength), juce::roundToInt (seconds * settings.sampleRate));
+        response.setSize (2, length);
+
+        for (int channel = 0; channel < response.getNumChannels(); ++channel)
+        {
+            juce::Random random (0x536d6561 + channel);
+            auto* samples = response.getWritePointer (channel);
+
+            for (int i = 0; i < length; ++i)
+                samples[i] = (random.nextFloat() * 2.0f - 1.0f) * std::exp (-6.9078f * static_cast<float> (i) / static_cast<float> (length));
+        }
+    }
+
+    // Unit energy, so SMEAR trades the echoes for their smear at about the same loudness
+    auto energy = 0.0;
+
+    for (int channel = 0; channel < response.getNumChannels(); ++channel)
+    {
+        auto* samples = response.getReadPointer (channel);
+
+        for (int i = 0; i < response.getNumSamples(); ++i)
+            energy += static_cast<double> (samples[i]) * samples[i];
+    }
+
+    energy /= response.getNumChannels();
+
+    if (energy > 0.0)
+        response.applyGain (static_cast<float> (1.0 / std::sqrt (energy)));
+
+    return response;
+}
+
+void SmearConvolver::publish (std::unique_ptr<Impulse> impulse)
+{
+    // One the audio thread hasn't taken yet is simply replaced
+    delete m_pending.exchange (impulse.release());
+}
+
+int SmearConvolver::getNumPartitions (const Stage& stage, int length) noexcept
+{
+    auto end = juce::jmin (length, stage.end);
+    return end > stage.start ? (end - stage.start + stage.blockSize - 1) / stage.blockSize : 0;
+}
+
+//==============================================================================
+void SmearConvolver::reset() noexcept
+{
+    // Whatever the worker is on is dropped when it comes back
+    m_generation.store (m_generation.load (std::memory_order_relaxed) + 1);
+
+    for (auto& stage : m_stages)
+    {
+        for (auto& task : stage.tasks)
+        {
+            int expected = queued;
+
+            if (! task.state.compare_exchange_strong (expected, idle) && expected == done)
+                task.state.store (idle, std::memory_order_relaxed);
+        }
+
+        stage.output.clear();
+    }
+
+    // The ring needn't be cleared: a window reaching back past the reset is filled with silence.
+    // Nor the history: the first task of the new generation starts it over
+    m_recent.clear();
+    m_position = 0;
+    m_blockFill = 0;
+}
+
+int SmearConvolver::getImpulseLength() const noexcept
+{
+    return m_current != nullptr ? m_current->length : 0;
+}
+
+bool SmearConvolver::swapPending() noexcept
+{
+    if (m_pending.load() == nullptr)
+        return false;
+
+    // The old one goes back to the worker, which has to have freed the one before
+    auto isRealtime = m_isRealtime.load();
+
+    if (isRealtime && m_retired.load() != nullptr)
+        return false;
+
+    auto* next = m_pending.exchange (nullptr);
+
+    // A new generation, so no task the worker runs from now on reads the old one
+    reset();
+    auto* previous = std::exchange (m_current, next);
+
+    if (isRealtime)
+    {
+        m_retired.store (previous);
+        wake();
+    }
+    else
+    {
+        delete previous;
+    }
+
+    return true;
+}
+
+void SmearConvolver::collect (Stage& stage, Task& task, juce::int64 dueBlock) noexcept
+{
+    auto state = task.state.load (std::memory_order_acquire);
+
+    if (state == done && task.generation == m_generation.load (std::memory_order_relaxed) && task.block == dueBlock)
+    {
+        for (int channel = 0; channel < task.numChannels; ++channel)
+            stage.output.copyFrom (channel, 0, task.result, channel, 0, stage.blockSize);
+
+        for (int channel = task.numChannels; channel < stage.output.getNumChannels(); ++channel)
+            stage.output.clear (channel, 0, stage.blockSize);
+    }
+    else
+    {
+        // Late, or dropped: the stage is silent for a block rather than the audio thread waiting
+        stage.output.clear();
+    }
+
+    // One still running is left to the worker, and its slot skipped until it is back
+    if (state == queued)
+    {
+        int expected = queued;
+
+        if (! task.state.compare_exchange_strong (expected, idle) && expected == done)
+            task.state.store (idle, std::memory_order_relaxed);
+    }
+    else if (state == done)
+    {
+        task.state.store (idle, std::memory_order_relaxed);
+    }
+}
+
+bool SmearConvolver::runOffline (Stage& stage, Task& task) noexcept
+{
+    if (m_isRealtime.load())
+        return false;
+
+    const juce::ScopedLock sl (m_offlineLock);
+
+    if (m_isRealtime.load())
+        return false;
+
+    runTask (stage, task, false);
+    return true;
+}
+
+void SmearConvolver::runTask (Stage& stage, Task& task, bool isWorker) noexcept
+{
+    auto& impulse = *task.impulse;
+    auto& kernels = m_kernels->get<float>();
+    const auto fftSize = 2 * stage.blockSize;
+    const auto numBins = stage.blockSize + 1;
+    const auto numPartitions = impulse.numPartitions[stage.index];
+
+    // A new generation starts the history over
+    if (task.generation != stage.lastGeneration)
+    {
+        stage.lastGeneration = task.generation;
+        stage.lastBlock = task.block - 1;
+        stage.numFilled = 0;
+    }
+
+    // Blocks that were dropped leave silence in the history, so the later partitions stay in step
+    auto numSkipped = static_cast<int> (juce::jlimit<juce::int64> (0, stage.maxPartitions, task.block - stage.lastBlock - 1));
+    stage.lastBlock = task.block;
+
+    for (int skipped = 0; skipped < numSkipped; ++skipped)
+    {
+        for (int channel = 0; channel < task.numChannels; ++channel)
+            juce::FloatVectorOperations::clear (stage.history.getWritePointer (channel * stage.maxPartitions + stage.nextSlot), fftSize + 2);
+
+        stage.nextSlot = (stage.nextSlot + 1) % stage.maxPartitions;
+        stage.numFilled = juce::jmin (stage.numFilled + 1, stage.maxPartitions);
+    }
+
+    // Uniformly partitioned overlap-save: transform the last two blocks, keep the
+    // transform for the later partitions, and sum each partition times its block
+    auto slot = stage.nextSlot;
+    stage.nextSlot = (stage.nextSlot + 1) % stage.maxPartitions;
+    stage.numFilled = juce::jmin (stage.numFilled + 1, stage.maxPartitions);
+    auto numUsed = juce::jmin (stage.numFilled, numPartitions);
+
+    auto* transform = stage.work.getWritePointer (0);
+    auto* sum = stage.work.getWritePointer (1);
+
+    for (int channel = 0; channel < task.numChannels; ++channel)
+    {
+        auto impulseChannel = channel % impulse.numChannels;
+
+        juce::FloatVectorOperations::copy (transform, task.window.getReadPointer (channel), fftSize);
+        juce::FloatVectorOperations::clear (transform + fftSize, fftSize);
+        stage.fft->performRealOnlyForwardTransform (transform, true);
+        juce::FloatVectorOperations::copy (stage.history.getWritePointer (channel * stage.maxPartitions + slot), transform, fftSize + 2);
+
+        juce::FloatVectorOperations::clear (sum, fftSize + 2);
+
+        for (int partition = 0; partition < numUsed; ++partition)
+        {
+            auto past = (slot - partition + stage.maxPartitions) % stage.maxPartitions;
+            kernels.complexMultiplyAdd (sum,
+                                        impulse.spectra[stage.index].getReadPointer (impulseChannel * numPartitions + partition),
+                                        stage.history.getReadPointer (channel * stage.maxPartitions + past),
+                                        numBins);
+        }
+
+        juce::FloatVectorOperations::copy (transform, sum, fftSize + 2);
+        stage.fft->performRealOnlyInverseTransform (transform);
+
+        // The first half wrapped around; the second is this block's output
+        task.result.copyFrom (channel, 0, transform + stage.blockSize, stage.blockSize);
+
+        // The shorter stages' blocks are due sooner
+        if (isWorker)
+            serviceTasks (stage.index);
+    }
+}
+
+//==============================================================================
+void SmearConvolver::convolve (int numSamples) noexcept
+{
+    auto& impulse = *m_current;
+
+    for (int done = 0; done < numSamples;)
+    {
+        // A chunk never crosses the end of a head block, so it never crosses a stage's either
+        auto numChunk = juce::jmin (numSamples - done, headLength - m_blockFill);
+        auto ringPosition = static_cast<int> (m_position % ringLength);
+
+        for (int channel = 0; channel < m_activeChannels; ++channel)
+        {
+            auto* input = m_wet.getReadPointer (channel, done);
+            auto* recent = m_recent.getWritePointer (channel, headLength + m_blockFill);
+            auto* output = m_convolved.getWritePointer (channel, done);
+            auto* taps = impulse.head.getReadPointer (channel % impulse.numChannels);
+
+            juce::FloatVectorOperations::copy (recent, input, numChunk);
+            juce::FloatVectorOperations::copy (m_ring.getWritePointer (channel, ringPosition), input, numChunk);
+
+            // The head, tap by tap along the chunk
+            juce::FloatVectorOperations::clear (output, numChunk);
+
+            for (int tap = 0; tap < headLength; ++tap)
+                juce::FloatVectorOperations::addWithMultiply (output, recent - tap, taps[tap], numChunk);
+
+            for (auto& stage : m_stages)
+                if (impulse.numPartitions[stage.index] > 0)
+                    juce::FloatVectorOperations::add (output, stage.output.getReadPointer (channel, static_cast<int> (m_position % stage.blockSize)), numChunk);
+        }
+
+        m_position += numChunk;
+        m_blockFill += numChunk;
+        done += numChunk;
+
+        if (m_blockFill == headLength)
+            endBlock();
+    }
+}
+
+void SmearConvolver::endBlock() noexcept
+{
+    m_blockFill = 0;
+    auto isQueued = false;
+
+    for (auto& stage : m_stages)
+    {
+        if (m_current->numPartitions[stage.index] == 0 || m_position % stage.blockSize != 0)
+            continue;
+
+        auto block = m_position / stage.blockSize;
+        auto& task = stage.tasks[stage.isBackground ? block % 2 : 0];
+
+        // The block handed over two blocks ago is due now, in the slot this one needs
+        if (stage.isBackground)
+        {
+            collect (stage, task, block - 2);
+
+            if (task.state.load (std::memory_order_acquire) != idle)
+                continue;       // still on the worker, so this block is dropped
+        }
+
+        // The window is the last two blocks, with silence before the reset
+        auto windowLength = 2 * stage.blockSize;
+        auto first = m_position - windowLength;
+        auto numSilent = static_cast<int> (juce::jlimit<juce::int64> (0, windowLength, -first));
+
+        for (int channel = 0; channel < m_activeChannels; ++channel)
+        {
+            auto* window = task.window.getWritePointer (channel);
+            juce::FloatVectorOperations::clear (window, numSilent);
+
+            for (int i = numSilent; i < windowLength;)
+            {
+                auto position = static_cast<int> ((first + i) % ringLength);
+                auto numCopied = juce::jmin (windowLength - i, ringLength - position);
+                juce::FloatVectorOperations::copy (window + i, m_ring.getReadPointer (channel, position), numCopied);
+                i += numCopied;
+            }
+        }
+
+        task.impulse = m_current;
+        task.numChannels = m_activeChannels;
+        task.block = block;
+        task.generation = m_generation.load (std::memory_order_relaxed);
+
+        if (! stage.isBackground)
+        {
+            // Due straight away
+            runTask (stage, task, false);
+
+            for (int channel = 0; channel < m_activeChannels; ++channel)
+                stage.output.copyFrom (channel, 0, task.result, channel, 0, stage.blockSize);
+        }
+        else if (runOffline (stage, task))
+        {
+            task.state.store (done, std::memory_order_relaxed);
+        }
+        else
+        {
+            task.state.store (queued, std::memory_order_release);
+            isQueued = true;
+        }
+    }
+
+    if (isQueued)
+        wake();
+
+    for (int channel = 0; channel < m_activeChannels; ++channel)
+        juce::FloatVectorOperations::copy (m_recent.getWritePointer (channel), m_recent.getReadPointer (channel, headLength), headLength);
+}
+
+//==============================================================================
+template <typename SampleType>
+void SmearConvolver::capture (const juce::AudioBuffer<SampleType>& subBlock, const float* amount) noexcept
+{
+    auto numSamples = subBlock.getNumSamples();
+    m_isActive = amount[0] > 0.0f || amount[numSamples - 1] > 0.0f;
+
+    // Resting, the convolver forgets its input, and a new impulse response can go straight in
+    if (! m_isActive)
+    {
+        m_needsReset = true;
+        swapPending();
+        return;
+    }
+
+    if (m_needsReset)
+    {
+        reset();
+        m_needsReset = false;
+    }
+
+    // A new impulse response waits for the smear to fade out, unless nothing has been heard yet
+    if (m_pending.load (std::memory_order_relaxed) != nullptr)
+    {
+        if (m_position == 0)
+            swapPending();
+        else
+            m_fade.setTargetValue (0.0f);
+    }
+
+    if (m_fade.getTargetValue() == 0.0f && ! m_fade.isSmoothing() && swapPending())
+        m_fade.setTargetValue (1.0f);
+
+    m_activeChannels = juce::jmin (subBlock.getNumChannels(), m_numChannels);
+
+    for (int channel = 0; channel < m_activeChannels; ++channel)
+    {
+        auto* source = subBlock.getReadPointer (channel);
+        auto* destination = m_wet.getWritePointer (channel);
+
+        if constexpr (std::is_same_v<SampleType, float>)
+            juce::FloatVectorOperations::copy (destination, source, numSamples);
+        else
+            for (int i = 0; i < numSamples; ++i)
+                destination[i] = static_cast<float> (source[i]);
+    }
+}
+
+template <typename SampleType>
+void SmearConvolver::process (juce::AudioBuffer<SampleType>& subBlock, const float* amount) noexcept
+{
+    if (! m_isActive)
+        return;
+
+    auto numSamples = subBlock.getNumSamples();
+
+    // What the delay added: the output less the input kept by capture()
+    for (int channel = 0; channel < m_activeChannels; ++channel)
+    {
+        auto* io = subBlock.getReadPointer (channel);
+        auto* wet = m_wet.getWritePointer (channel);
+
+        for (int i = 0; i < numSamples; ++i)
+            wet[i] = static_cast<float> (io[i]) - wet[i];
+    }
+
+    convolve (numSamples);
+
+    auto* gain = m_gain.getWritePointer (0);
+
+    if (m_fade.isSmoothing())
+    {
+        for (int i = 0; i < numSamples; ++i)
+            gain[i] = amount[i] * m_fade.getNextValue();
+    }
+    else
+    {
+        juce::FloatVectorOperations::multiply (gain, amount, m_fade.getCurrentValue(), numSamples);
+    }
+
+    // io + amount * (convolved - wet): the echoes crossfaded into their smear
+    for (int channel = 0; channel < m_activeChannels; ++channel)
+    {
+        auto* io = subBlock.getWritePointer (channel);
+        auto* convolved = m_convolved.getWritePointer (channel);
+
+        juce::FloatVectorOperations::subtract (convolved, m_wet.getReadPointer (channel), numSamples);
+        juce::FloatVectorOperations::multiply (convolved, gain, numSamples);
+
+        if constexpr (std::is_same_v<SampleType, float>)
+            juce::FloatVectorOperations::add (io, convolved, numSamples);
+        else
+            for (int i = 0; i < numSamples; ++i)
+                io[i] += static_cast<SampleType> (convolved[i]);
+    }
+}
+
+template void SmearConvolver::capture (const juce::AudioBuffer<float>&, const float*) noexcept;
+template void SmearConvolver::capture (const juce::AudioBuffer<double>&, const float*) noexcept;
+template void SmearConvolver::process (juce::AudioBuffer<float>&, const float*) noexcept;
+template void SmearConvolver::process (juce::AudioBuffer<double>&, const float*) noexcept;
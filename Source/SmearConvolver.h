@@ -0,0 +1,266 @@
+/*
+  ==============================================================================
+
+    SmearConvolver.h
+    Created: 23 Oct 2026 4:37:12pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "KernelDispatch.h"
+
+#include <semaphore>
+
+//==============================================================================
+/**
+    The smear: convolves the wet signal with an impulse response of up to
+    maxImpulseSeconds, so the repeats can blur into a room or a cloud
+    without a reverb after the plugin. SMEAR crossfades each echo into its
+    convolved version. The impulse response is generated (decaying noise
+    SMEARTIME long) unless one has been loaded from a file.
+
+    The convolution is non-uniformly partitioned and adds no latency. The
+    first headLength taps run as a direct-form FIR. The rest of the impulse
+    response is cut into stages of growing partitions, each convolved in the
+    frequency domain one block at a time:
+
+        taps            block   transform
+        64 - 1.5k       64      on the audio thread, at every block
+        1.5k - 6k       512     on the worker thread
+        6k - 24k        2048    on the worker thread
+        24k - the end   8192    on the worker thread
+
+    The worker's stages start three of their blocks into the impulse
+    response. A block handed to the worker when it is complete is only heard
+    two blocks later, so the worker has two blocks' time for it, and each
+    stage keeps two blocks in flight. The audio thread never runs a worker
+    block and never waits for one: a block that isn't ready when it is due
+    is dropped, and plays as silence in that stage. reset() starts a new
+    generation, and the worker throws away anything from an older one. The
+    worker sleeps until the audio thread hands it a block, and is only
+    started once the smear is first turned up or given a file. Offline there
+    is no worker, and every block is done as soon as it is complete, so
+    renders come out the same every time.
+
+    The impulse responses are built on the worker thread, partitions and all,
+    and handed to the audio thread through an atomic pointer. It fades the
+    smear out, swaps the impulse response in and fades back in, and hands
+    the old one back to the worker to free.
+
+    The wet signal is what the delay added to the sub-block, so the smear
+    works the same for every mode and stays outside the feedback loop, where
+    no impulse response can make the repeats run away. It runs in float in
+    either processing precision.
+*/
+class SmearConvolver  : private juce::Thread,
+                        private juce::AudioProcessorValueTreeState::Listener,
+                        private juce::AsyncUpdater
+{
+public:
+    explicit SmearConvolver (juce::AudioProcessorValueTreeState& apvts);
+    ~SmearConvolver() override;
+
+    static constexpr double maxImpulseSeconds = 4.0;
+    static constexpr int headLength = 64;
+
+    //==============================================================================
+    // Message thread
+    /** Reads an impulse response from an audio file and uses it from now on. */
+    juce::Result loadImpulseResponse (const juce::File& file);
+
+    /** Uses an impulse response at the given sample rate, cut to maxImpulseSeconds. */
+    void setImpulseResponse (const juce::AudioBuffer<float>& impulse, double sampleRate, const juce::File& file = {});
+
+    /** Goes back to the generated impulse response. */
+    void clearImpulseResponse();
+
+    /** The file the impulse response was loaded from, if any. */
+    juce::File getImpulseFile() const;
+
+    /** Length of the impulse response in use, or to be used, in seconds. */
+    double getImpulseSeconds() const;
+
+    /** Builds the impulse response for the sample rate and allocates every stage for
+        maxImpulseSeconds. Starts the worker if the smear is in use, unless offline.
+        Not real-time safe, and not to be called while processing.
+    */
+    void prepare (double sampleRate, int numChannels, int maxSpanSize, bool isRealtime, const KernelDispatch::Table& kernels);
+
+    /** Stops or starts the worker when the host switches to or from offline
+        rendering. Not real-time safe; may be called while processing.
+    */
+    void setRealtime (bool isRealtime);
+
+    //==============================================================================
+    // Audio thread
+    /** Offline, rebuilds the impulse response right away if its settings changed. */
+    void update();
+
+    /** Forgets all input, cutting the smear's tail. Blocks the worker is still on are
+        left to it, and thrown away when they come back.
+    */
+    void reset() noexcept;
+
+    /** Length of the impulse response in use, in samples. */
+    int getImpulseLength() const noexcept;
+
+    /** Keeps a copy of the sub-block before the delay adds its wet signal. amount is
+        the SMEAR ramp; while it stays at zero the convolver rests.
+    */
+    template <typename SampleType>
+    void capture (const juce::AudioBuffer<SampleType>& subBlock, const float* amount) noexcept;
+
+    /** Takes what the delay added since capture(), convolves it and crossfades it
+        into its convolved version by amount, in place.
+    */
+    template <typename SampleType>
+    void process (juce::AudioBuffer<SampleType>& subBlock, const float* amount) noexcept;
+
+private:
+    static constexpr int numStages = 4;
+    static constexpr int maxImpulseChannels = 16;
+
+    // Each stage's blocks pass from the audio thread to the worker and back
+    enum TaskState
+    {
+        idle,
+        queued,
+        running,
+        done
+    };
+
+    /** One impulse response, cut into each stage's partitions and transformed.
+        Never changed once built.
+    */
+    struct Impulse
+    {
+        int length = 0;
+        int numChannels = 0;
+        juce::AudioBuffer<float> head;                  // the first headLength taps of each channel
+        juce::AudioBuffer<float> spectra[numStages];    // row channel * numPartitions + partition
+        int numPartitions[numStages] = {};
+    };
+
+    // What an Impulse is built from
+    struct Settings
+    {
+        double sampleRate = 0.0;
+        float decaySeconds = 0.0f;                      // 0 for a loaded impulse response
+        int sourceVersion = 0;
+
+        bool operator!= (const Settings& other) const noexcept
+        {
+            return sampleRate != other.sampleRate || decaySeconds != other.decaySeconds || sourceVersion != other.sourceVersion;
+        }
+    };
+
+    // One block of a stage: its input, the last two blocks, and its output
+    struct Task
+    {
+        juce::AudioBuffer<float> window, result;
+        const Impulse* impulse = nullptr;
+        int numChannels = 0;
+        juce::int64 block = 0;                          // the position it ends at, in the stage's blocks
+        int generation = -1;
+        std::atomic<int> state { idle };
+    };
+
+    struct Stage
+    {
+        int index = 0;
+        int blockSize = 0, start = 0, end = 0;
+        bool isBackground = false;
+        int maxPartitions = 0;
+        std::unique_ptr<juce::dsp::FFT> fft;
+
+        // Whoever runs the tasks: the transformed input blocks, and scratch
+        juce::AudioBuffer<float> history;               // row channel * maxPartitions + slot
+        int nextSlot = 0, numFilled = 0;
+        juce::int64 lastBlock = 0;
+        int lastGeneration = -1;
+        juce::AudioBuffer<float> work;
+
+        // The blocks in flight, by parity; the audio thread's own stage only uses the first
+        Task tasks[2];
+
+        // Audio thread: the output being played out
+        juce::AudioBuffer<float> output;
+    };
+
+    void run() override;
+    void parameterChanged (const juce::String& parameterID, float newValue) override;
+    void handleAsyncUpdate() override;
+
+    void startWorkerIfNeeded();
+    void stopWorker();
+    void wake() noexcept;
+
+    Settings getSettings() const;
+    std::unique_ptr<Impulse> build (const Settings& settings);
+    juce::AudioBuffer<float> makeResponse (const Settings& settings) const;
+    void publish (std::unique_ptr<Impulse> impulse);
+    bool serviceTasks (int numStagesToService) noexcept;
+
+    void runTask (Stage& stage, Task& task, bool isWorker) noexcept;
+    bool runOffline (Stage& stage, Task& task) noexcept;
+    void collect (Stage& stage, Task& task, juce::int64 dueBlock) noexcept;
+    bool swapPending() noexcept;
+    void convolve (int numSamples) noexcept;
+    void endBlock() noexcept;
+
+    static int getNumPartitions (const Stage& stage, int length) noexcept;
+
+    juce::AudioProcessorValueTreeState& m_apvts;
+    std::atomic<float>* m_amount;
+    std::atomic<float>* m_decay;
+    double m_sampleRate = 44100.0;
+    int m_maxLength = 0;
+    int m_numChannels = 0;
+    const KernelDispatch::Table* m_kernels = nullptr;
+
+    // Offline, the audio thread runs the tasks and builds under m_offlineLock. Switching to
+    // realtime takes the lock, so the worker never starts while the audio thread is at it
+    std::atomic<bool> m_isRealtime { true };
+    juce::CriticalSection m_offlineLock;
+
+    // Wakes the worker. Thread::notify() takes a mutex, which the audio thread mustn't;
+    // releasing a semaphore doesn't, and m_wakePending keeps it from being released twice
+    std::binary_semaphore m_wake { 0 };
+    std::atomic<bool> m_wakePending { false };
+
+    // A loaded impulse response, as it came; message thread and worker
+    mutable juce::CriticalSection m_sourceLock;
+    juce::AudioBuffer<float> m_source;
+    double m_sourceRate = 0.0;
+    juce::File m_sourceFile;
+    std::atomic<int> m_sourceVersion { 0 };
+    std::atomic<bool> m_hasSource { false };
+
+    // The worker builds into m_pending; the audio thread swaps it in for m_current
+    // and leaves the old one in m_retired for the worker to free
+    Settings m_built;
+    std::unique_ptr<juce::dsp::FFT> m_buildFfts[numStages];
+    std::atomic<Impulse*> m_pending { nullptr };
+    std::atomic<Impulse*> m_retired { nullptr };
+    Impulse* m_current = nullptr;
+
+    // Audio thread; the worker drops tasks of an older generation
+    std::atomic<int> m_generation { 0 };
+    Stage m_stages[numStages];
+    juce::AudioBuffer<float> m_ring;                    // recent input, for the stages' windows
+    juce::AudioBuffer<float> m_recent;                  // the last two head blocks, for the FIR
+    juce::AudioBuffer<float> m_wet, m_convolved;
+    juce::AudioBuffer<float> m_gain;
+    juce::SmoothedValue<float> m_fade { 1.0f };
+    juce::int64 m_position = 0;                         // samples since the last reset
+    int m_blockFill = 0;
+    int m_activeChannels = 0;
+    bool m_isActive = false;
+    bool m_needsReset = true;
+
+    JUCE_DECLARE_NON_COPYABLE (SmearConvolver)
+};
@@ -50,13 +50,43 @@ public:
 
     void draw(juce::Graphics& g, float opacity) const
     {
+        auto translation = juce::AffineTransform::translation(position);
+
         g.setColour(juce::Colours::darkgrey.withAlpha(objectAlpha));
-        g.fillPath(transformedPath);
+        g.fillPath(objectPath, translation);
 
         g.setColour(juce::Colours::black.withAlpha(objectAlpha));
-        g.strokePath(transformedPath, juce::PathStrokeType(1.0f));
+        g.strokePath(objectPath, juce::PathStrokeType(1.0f), translation);
+    }
+
+    /** The object drawn once, fully opaque, at the given pixel scale. Every
+        object has the same shape, so one sprite drawn with each object's
+        alpha at getSpriteBounds() replaces filling and stroking its path.
+    */
+    juce::Image createSprite(float scale) const
+    {
+        auto area = getLocalSpriteBounds();
+        juce::Image sprite(juce::Image::ARGB, juce::roundToInt(area.getWidth() * scale),
+                           juce::roundToInt(area.getHeight() * scale), true);
+
+        juce::Graphics g(sprite);
+        g.addTransform(juce::AffineTransform::translation(-area.getPosition()).scaled(scale));
+        g.setColour(juce::Colours::darkgrey);
+        g.fillPath(objectPath);
+        g.setColour(juce::Colours::black);
+        g.strokePath(objectPath, juce::PathStrokeType(1.0f));
+        return sprite;
+    }
+
+    /** Where the sprite goes for the current position, including the outline. */
+    juce::Rectangle<float> getSpriteBounds() const
+    {
+        return getLocalSpriteBounds() + position;
     }
 
+    float getAlpha() const { return objectAlpha; }
+    juce::Point<float> getPosition() const { return position; }
+
     std::unique_ptr<juce::Drawable> createCopy() const override
     {
         return std::make_unique<SpaceObject>();
@@ -73,11 +103,9 @@ public:
         objectAlpha = juce::jlimit(0.0f, 1.0f, newAlpha);
     }
 
+    // Only the offset is stored; the path is translated when it is drawn
     void setPosition(float x, float y)
     {
-        auto translation = juce::AffineTransform::translation(x, y);
-        transformedPath = objectPath; // Copy original path
-        transformedPath.applyTransform(translation);
         position = { x, y };
     }
 
@@ -87,8 +115,13 @@ public:
     }
 
 private:
+    // Whole pixels around the path and its one pixel outline, so the sprite isn't resampled at rest
+    juce::Rectangle<float> getLocalSpriteBounds() const
+    {
+        return objectPath.getBounds().expanded(1.0f).getSmallestIntegerContainer().toFloat();
+    }
+
 	juce::Path objectPath;
-    juce::Path transformedPath;
 	juce::Rectangle<float> objectBoundingBox;
     juce::Point<float> position;
 	float objectAlpha;
@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    SpeakerLayout.h
+    Created: 19 Oct 2026 4:05:31pm
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Where each channel of the main bus sits, as far as the delay cares.
+
+    STEREO generalises to a per-speaker delay offset: speakers on the left
+    use DELAYTIME as is, speakers on the right add the full STEREO time and
+    centre speakers add half of it. A stereo pair keeps the original
+    left/right behaviour. Ambisonic components all get the same delay, since
+    offsetting them against each other would smear the soundfield.
+
+    The side of a speaker (-1, 0 or 1) also picks its half of the multi-tap
+    pan law.
+*/
+class SpeakerLayout
+{
+public:
+    static constexpr int maxChannels = 16;     // third-order ambisonics
+
+    SpeakerLayout()     { setChannelSet (juce::AudioChannelSet::stereo()); }
+
+    /** Mono, stereo, named surround layouts up to 7.1.4 and ambisonics of order 1 to 3. */
+    static bool isSupported (const juce::AudioChannelSet& set)
+    {
+        auto order = set.getAmbisonicOrder();
+
+        if (order >= 0)
+            return order >= 1 && order <= 3;
+
+        return ! set.isDisabled() && ! set.isDiscreteLayout() && set.size() <= 12;
+    }
+
+    /** A supported layout with the given number of channels, for the developer tools,
+        or a disabled set if no supported layout has that many.
+    */
+    static juce::AudioChannelSet getDefaultChannelSet (int numChannels)
+    {
+        switch (numChannels)
+        {
+            case 1:     return juce::AudioChannelSet::mono();
+            case 2:     return juce::AudioChannelSet::stereo();
+            case 4:     return juce::AudioChannelSet::ambisonic (1);
+            case 6:     return juce::AudioChannelSet::create5point1();
+            case 8:     return juce::AudioChannelSet::create7point1();
+            case 9:     return juce::AudioChannelSet::ambisonic (2);
+            case 12:    return juce::AudioChannelSet::create7point1point4();
+            case 16:    return juce::AudioChannelSet::ambisonic (3);
+            default:    return juce::AudioChannelSet::disabled();
+        }
+    }
+
+    void setChannelSet (const juce::AudioChannelSet& set)
+    {
+        jassert (set.size() <= maxChannels);
+        m_numChannels = juce::jmin (set.size(), maxChannels);
+
+        for (int channel = 0; channel < m_numChannels; ++channel)
+        {
+            m_sides[channel] = getSide (set.getTypeOfChannel (channel));
+            m_offsets[channel] = set == juce::AudioChannelSet::mono() || set.getAmbisonicOrder() >= 0
+                                   ? 0.0f
+                                   : (m_sides[channel] + 1.0f) * 0.5f;
+        }
+    }
+
+    int getNumChannels() const noexcept                 { return m_numChannels; }
+
+    /** Share of STEREO added to the delay of a channel, 0 to 1. */
+    float getOffset (int channel) const noexcept        { return m_offsets[channel]; }
+
+    /** -1 for left speakers, 1 for right ones, 0 for centre and non-directional channels. */
+    float getSide (int channel) const noexcept          { return m_sides[channel]; }
+
+private:
+    static float getSide (juce::AudioChannelSet::ChannelType type) noexcept
+    {
+        using Set = juce::AudioChannelSet;
+
+        switch (type)
+        {
+            case Set::left:             case Set::leftCentre:           case Set::leftSurround:
+            case Set::leftSurroundSide: case Set::leftSurroundRear:     case Set::wideLeft:
+            case Set::topFrontLeft:     case Set::topRearLeft:          case Set::topSideLeft:
+            case Set::bottomFrontLeft:  case Set::bottomRearLeft:       case Set::bottomSideLeft:
+                return -1.0f;
+
+            case Set::right:            case Set::rightCentre:          case Set::rightSurround:
+            case Set::rightSurroundSide: case Set::rightSurroundRear:   case Set::wideRight:
+            case Set::topFrontRight:    case Set::topRearRight:         case Set::topSideRight:
+            case Set::bottomFrontRight: case Set::bottomRearRight:      case Set::bottomSideRight:
+                return 1.0f;
+
+            default:
+                return 0.0f;
+        }
+    }
+
+    int m_numChannels = 0;
+    float m_offsets[maxChannels] = {};
+    float m_sides[maxChannels] = {};
+};
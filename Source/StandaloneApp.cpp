@@ -0,0 +1,287 @@
+/*
+  ==============================================================================
+
+    StandaloneApp.cpp
+    Created: 18 Oct 2026 10:40:07am
+    Author:  97252
+
+    The standalone target is built with JUCE_USE_CUSTOM_PLUGIN_STANDALONE_APP,
+    so instead of the default plugin window it runs headless developer
+    commands against FractureAudioProcessor.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "BatchRenderer.h"
+#include "PresetLibrary.h"
+#include "ProcessorBenchmark.h"
+#include "RealtimeAudit.h"
+#include "RealtimeAuditHarness.h"
+#include "StateRecall.h"
+
+#include <iostream>
+
+//==============================================================================
+class FractureStandaloneApp : public juce::JUCEApplication
+{
+public:
+    FractureStandaloneApp()
+    {
+        m_commands.addHelpCommand ("--help|-h", "Usage:", true);
+
+        m_commands.addCommand ({ "--benchmark",
+                                 "--benchmark [--quick] [--layouts] [--half] [--double] [--diffuse] [--smear] [--isa] [--seconds=N] [--baseline=file.csv] [--save=file.csv] [--tolerance=percent]",
+                                 "Times processBlock over a matrix of sample rates, block sizes, layouts and parameters.",
+                                 "Reports ns/sample and p50/p99/max block time per configuration. With --baseline, "
+                                 "each configuration is compared against the stored results and the exit code is the "
+                                 "number of configurations slower than the tolerance (default 10%). --layouts adds an "
+                                 "interleaved delay line run next to every stereo configuration, and --half a "
+                                 "half-precision delay line run next to every configuration, --double a run through "
+                                 "the double-precision processBlock, and --diffuse runs of the 8 and 16 line diffuse mode, "
+                                 "with their cost relative to the single line. --smear adds a run with the convolution "
+                                 "smear on, with all of its work counted on the processing thread. "
+                                 "The kernel instruction set "
+                                 "in use is printed first; --isa runs every configuration with each variant the CPU "
+                                 "supports and reports its speed-up over the scalar kernels.",
+                                 [] (const juce::ArgumentList& args) { runBenchmark (args); } });
+
+        m_commands.addCommand ({ "--audit",
+                                 "--audit [--runs=N] [--blocks=N] [--seed=N]",
+                                 "Fails if processBlock allocates or locks (needs an Audit build).",
+                                 "Drives the processor through random layouts, sample rates, block sizes, parameter sweeps "
+                                 "and silences, in float and double, with MODE switches into Diffuse, live state recalls and "
+                                 "the smear's worker, with the audio-thread hooks of FRACTURE_REALTIME_AUDIT armed, and stops with "
+                                 "a stack trace at the first allocation, free or mutex lock inside processBlock.",
+                                 [] (const juce::ArgumentList& args) { runAudit (args); } });
+
+        m_commands.addCommand ({ "--render",
+                                 "--render [--preset=file] [--automation=file.csv] [--impulse=file] [--output=dir] [--suffix=text] [--tail=seconds] [--threads=N] [--chunk=N] files or directories...",
+                                 "Processes WAV, AIFF and FLAC files offline and writes the results.",
+                                 "Files are spread over one worker per core (or --threads), each with its own processor, and "
+                                 "streamed through in chunks of --chunk samples (default 4096). The preset is a saved plugin "
+                                 "state, the parameter XML or lines of \"ID value\"; the automation file has lines of \"seconds,ID,value\". "
+                                 "--impulse is an audio file for the smear to convolve with, in place of the preset's. "
+                                 "Output goes next to each input, or into --output, named with --suffix (default _fracture). "
+                                 "--tail renders that much silence after the input. The exit code is the number of failed files.",
+                                 [] (const juce::ArgumentList& args) { runRender (args); } });
+
+        m_commands.addCommand ({ "--library",
+                                 "--library [--output=file] preset files or directories...",
+                                 "Builds the preset library the editor browses from preset files.",
+                                 "Every preset (a saved plugin state or the parameter XML) becomes one entry, named after "
+                                 "its file and tagged with the folders between it and the directory given. The library "
+                                 "is written to --output, or to where the plugin looks for it by default, and replaces "
+                                 "any library already there.",
+                                 [] (const juce::ArgumentList& args) { runLibrary (args); } });
+    }
+
+    const juce::String getApplicationName() override       { return JucePlugin_Name; }
+    const juce::String getApplicationVersion() override    { return JucePlugin_VersionString; }
+    bool moreThanOneInstanceAllowed() override             { return true; }
+
+    void initialise (const juce::String&) override
+    {
+        juce::ArgumentList args (getApplicationName(), getCommandLineParameterArray());
+        setApplicationReturnValue (m_commands.findAndRunCommand (args));
+        quit();
+    }
+
+    void shutdown() override {}
+    void systemRequestedQuit() override { quit(); }
+    void anotherInstanceStarted (const juce::String&) override {}
+
+private:
+    static void runBenchmark (const juce::ArgumentList& args)
+    {
+        ProcessorBenchmark::Options options;
+        options.quick = args.containsOption ("--quick");
+        options.compareLayouts = args.containsOption ("--layouts");
+        options.compareStorage = args.containsOption ("--half");
+        options.compareIsas = args.containsOption ("--isa");
+        options.comparePrecision = args.containsOption ("--double");
+        options.compareDiffusion = args.containsOption ("--diffuse");
+        options.compareSmear = args.containsOption ("--smear");
+
+        if (args.containsOption ("--seconds"))
+            options.secondsPerConfig = juce::jmax (0.01, args.getValueForOption ("--seconds").getDoubleValue());
+
+        ProcessorBenchmark benchmark (options);
+        auto results = benchmark.runAll (ProcessorBenchmark::createMatrix (options.quick, options.compareLayouts,
+                                                                           options.compareStorage, options.compareIsas,
+                                                                           options.comparePrecision, options.compareDiffusion,
+                                                                           options.compareSmear));
+
+        if (options.compareIsas)
+        {
+            std::cout << std::endl;
+            ProcessorBenchmark::printIsaSpeedups (results);
+        }
+
+        if (options.compareDiffusion)
+        {
+            std::cout << std::endl;
+            ProcessorBenchmark::printDiffusionCosts (results);
+        }
+
+        if (args.containsOption ("--save"))
+        {
+            auto file = args.getFileForOption ("--save");
+
+            if (! ProcessorBenchmark::writeCsv (file, results))
+                juce::ConsoleApplication::fail ("Could not write " + file.getFullPathName());
+        }
+
+        if (args.containsOption ("--baseline"))
+        {
+            auto baseline = ProcessorBenchmark::readCsv (args.getExistingFileForOption ("--baseline"));
+            auto tolerance = args.containsOption ("--tolerance") ? args.getValueForOption ("--tolerance").getDoubleValue()
+                                                                 : 10.0;
+
+            std::cout << std::endl;
+            auto numRegressions = ProcessorBenchmark::compareWithBaseline (results, baseline, tolerance);
+
+            if (numRegressions > 0)
+                juce::ConsoleApplication::fail (juce::String (numRegressions) + " configuration(s) regressed", numRegressions);
+        }
+    }
+
+    static void runAudit (const juce::ArgumentList& args)
+    {
+        if (! RealtimeAudit::isAvailable())
+            juce::ConsoleApplication::fail ("This build has no audit hooks: build the Audit configuration (FRACTURE_REALTIME_AUDIT=1)");
+
+        RealtimeAuditHarness::Options options;
+
+        if (args.containsOption ("--runs"))
+            options.numRuns = juce::jmax (1, args.getValueForOption ("--runs").getIntValue());
+
+        if (args.containsOption ("--blocks"))
+            options.blocksPerRun = juce::jmax (1, args.getValueForOption ("--blocks").getIntValue());
+
+        if (args.containsOption ("--seed"))
+            options.seed = args.getValueForOption ("--seed").getLargeIntValue();
+
+        if (! RealtimeAuditHarness (options).run())
+            juce::ConsoleApplication::fail ("processBlock is not real-time safe");
+    }
+
+    static void runRender (const juce::ArgumentList& args)
+    {
+        BatchRenderer::Options options;
+
+        if (args.containsOption ("--preset"))
+            options.preset = args.getExistingFileForOption ("--preset");
+
+        if (args.containsOption ("--automation"))
+            options.automation = args.getExistingFileForOption ("--automation");
+
+        if (args.containsOption ("--impulse"))
+            options.impulse = args.getExistingFileForOption ("--impulse");
+
+        if (args.containsOption ("--output"))
+            options.outputDirectory = args.getFileForOption ("--output");
+
+        if (args.containsOption ("--suffix"))
+            options.suffix = args.getValueForOption ("--suffix");
+
+        if (args.containsOption ("--tail"))
+            options.tailSeconds = juce::jmax (0.0, args.getValueForOption ("--tail").getDoubleValue());
+
+        if (args.containsOption ("--threads"))
+            options.numThreads = juce::jmax (1, args.getValueForOption ("--threads").getIntValue());
+
+        if (args.containsOption ("--chunk"))
+            options.chunkSize = juce::jmax (1, args.getValueForOption ("--chunk").getIntValue());
+
+        BatchRenderer renderer (options);
+        auto settings = renderer.loadSettings();
+
+        if (settings.failed())
+            juce::ConsoleApplication::fail (settings.getErrorMessage());
+
+        juce::Array<juce::File> paths;
+
+        for (auto& argument : args.arguments)
+            if (! argument.isOption())
+                paths.add (argument.resolveAsExistingFile());
+
+        auto inputs = renderer.findInputFiles (paths);
+
+        if (inputs.isEmpty())
+            juce::ConsoleApplication::fail ("No audio files to render");
+
+        int numFailures = 0;
+
+        for (auto& result : renderer.renderAll (inputs))
+            if (! result.wasOk())
+                ++numFailures;
+
+        if (numFailures > 0)
+            juce::ConsoleApplication::fail (juce::String (numFailures) + " file(s) failed", numFailures);
+    }
+
+    static void runLibrary (const juce::ArgumentList& args)
+    {
+        auto target = args.containsOption ("--output") ? args.getFileForOption ("--output") : PresetLibrary::getDefaultFile();
+        PresetLibrary::Builder builder;
+
+        for (auto& argument : args.arguments)
+        {
+            if (argument.isOption())
+                continue;
+
+            auto root = argument.resolveAsExistingFile();
+            auto files = root.isDirectory() ? root.findChildFiles (juce::File::findFiles, true) : juce::Array<juce::File> { root };
+
+            for (auto& file : files)
+            {
+                juce::MemoryBlock data;
+                juce::NamedValueSet values;
+
+                if (file.isHidden())
+                    continue;
+
+                if (! file.loadFileAsData (data) || ! StateRecall::parse (data.getData(), data.getSize(), values))
+                {
+                    std::cout << "Skipped " << file.getFullPathName() << ": not a preset" << std::endl;
+                    continue;
+                }
+
+                juce::StringArray tags;
+
+                if (root.isDirectory())
+                {
+                    tags.addTokens (file.getParentDirectory().getRelativePathFrom (root), "/\\", {});
+                    tags.removeString (".");
+                    tags.removeEmptyStrings();
+                }
+
+                // Stored in the binary state format, whatever the file was
+                juce::MemoryBlock state;
+                StateRecall::write (values, state);
+                builder.add (file.getFileNameWithoutExtension(), tags, state);
+            }
+        }
+
+        if (builder.getNumPresets() == 0)
+            juce::ConsoleApplication::fail ("No presets to add");
+
+        target.getParentDirectory().createDirectory();
+        auto result = builder.write (target);
+
+        if (result.failed())
+            juce::ConsoleApplication::fail (result.getErrorMessage());
+
+        std::cout << "Wrote " << builder.getNumPresets() << " presets to " << PresetLibrary::getLatestVersion (target).getFullPathName() << std::endl;
+    }
+
+    juce::ConsoleApplication m_commands;
+};
+
+//==============================================================================
+// Required by the standalone wrapper when JUCE_USE_CUSTOM_PLUGIN_STANDALONE_APP is set
+juce::JUCEApplicationBase* juce_CreateApplication()
+{
+    return new FractureStandaloneApp();
+}
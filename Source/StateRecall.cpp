@@ -0,0 +1,331 @@
+/*
+  ==============================================================================
+
+    StateRecall.cpp
+    Created: 22 Oct 2026 10:12:31am
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#include "StateRecall.h"
+
+//==============================================================================
+StateRecall::StateRecall (juce::AudioProcessorValueTreeState& apvts)
+{
+    for (auto* parameter : apvts.processor.getParameters())
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (parameter))
+            m_parameters.push_back (ranged);
+}
+
+StateRecall::~StateRecall()
+{
+    stopTimer();
+    delete m_staged.exchange (nullptr);
+}
+
+//==============================================================================
+void StateRecall::writeState (juce::MemoryBlock& destination) const
+{
+    juce::NamedValueSet values;
+
+    for (auto* parameter : m_parameters)
+        values.set (parameter->paramID, parameter->convertFrom0to1 (parameter->getValue()));
+
+    write (values, destination);
+}
+
+void StateRecall::write (const juce::NamedValueSet& values, juce::MemoryBlock& destination)
+{
+    juce::MemoryOutputStream parameters;
+    parameters.writeShort (static_cast<short> (values.size()));
+
+    for (auto& value : values)
+    {
+        auto& name = value.name.toString();
+        auto id = name.toUTF8();
+        auto length = juce::jmin (static_cast<int> (id.sizeInBytes()) - 1, 255);
+
+        parameters.writeByte (static_cast<char> (length));
+        parameters.write (id.getAddress(), static_cast<size_t> (length));
+        parameters.writeFloat (static_cast<float> (value.value));
+    }
+
+    juce::MemoryOutputStream output (destination, false);
+    output.writeInt (static_cast<int> (magic));
+    output.writeShort (static_cast<short> (formatVersion));
+    output.writeInt (static_cast<int> (parameterChunk));
+    output.writeInt (static_cast<int> (parameters.getDataSize()));
+    output.write (parameters.getData(), parameters.getDataSize());
+}
+
+bool StateRecall::readState (const void* data, int sizeInBytes)
+{
+    juce::NamedValueSet values;
+
+    if (sizeInBytes <= 0 || ! parse (data, static_cast<size_t> (sizeInBytes), values))
+        return false;
+
+    stage (values);
+
+    if (! m_isLive)
+    {
+        applyStaged();
+        return true;
+    }
+
+    requestFade();
+    startTimer (timerIntervalMs);
+    return true;
+}
+
+void StateRecall::requestFade() noexcept
+{
+    // A recall already under way picks the new values up unless they've been set;
+    // then it goes round again, which starts with the wet already out
+    for (;;)
+    {
+        auto phase = m_phase.load();
+
+        if ((phase != idle && phase != applied) || advance (static_cast<Phase> (phase), fadeRequested))
+            break;
+    }
+}
+
+template <typename Visitor>
+bool StateRecall::readChunks (const void* data, size_t sizeInBytes, Visitor&& visit)
+{
+    juce::MemoryInputStream input (data, sizeInBytes, false);
+
+    // A newer version keeps the chunk layout, so only its new chunks get skipped
+    if (sizeInBytes < 6 || static_cast<juce::uint32> (input.readInt()) != magic || input.readShort() < 1)
+        return false;
+
+    while (input.getNumBytesRemaining() >= 8)
+    {
+        auto tag = static_cast<juce::uint32> (input.readInt());
+        auto size = static_cast<juce::int64> (static_cast<juce::uint32> (input.readInt()));
+        auto end = input.getPosition() + size;
+
+        if (size > input.getNumBytesRemaining() || ! visit (tag, input, size))
+            return false;
+
+        input.setPosition (end);
+    }
+
+    return true;
+}
+
+bool StateRecall::parse (const void* data, size_t sizeInBytes, juce::NamedValueSet& values)
+{
+    values.clear();
+
+    if (sizeInBytes >= 4 && juce::ByteOrder::littleEndianInt (data) == magic)
+    {
+        return readChunks (data, sizeInBytes, [&values] (juce::uint32 tag, juce::MemoryInputStream& input, juce::int64 size)
+        {
+            if (tag != parameterChunk || size < 2)
+                return true;
+
+            auto end = input.getPosition() + size;
+            auto count = static_cast<juce::uint16> (input.readShort());
+
+            for (int i = 0; i < count && input.getPosition() < end; ++i)
+            {
+                auto length = static_cast<juce::uint8> (input.readByte());
+
+                if (input.getPosition() + length + 4 > end)
+                    return false;
+
+                juce::MemoryBlock id;
+                input.readIntoMemoryBlock (id, length);
+                auto value = input.readFloat();
+
+                if (length > 0)
+                    values.set (juce::String::fromUTF8 (static_cast<const char*> (id.getData()), length), value);
+            }
+
+            return true;
+        });
+    }
+
+    // JUCE's wrapped XML, or the plain text of a preset file
+    auto xml = juce::AudioProcessor::getXmlFromBinary (data, static_cast<int> (sizeInBytes));
+
+    if (xml == nullptr)
+        xml = juce::parseXML (juce::String::fromUTF8 (static_cast<const char*> (data), static_cast<int> (sizeInBytes)));
+
+    if (xml == nullptr)
+        return false;
+
+    for (auto* element : xml->getChildIterator())
+        if (element->hasAttribute ("id") && element->hasAttribute ("value") && element->getStringAttribute ("id").isNotEmpty())
+            values.set (element->getStringAttribute ("id"), element->getDoubleAttribute ("value"));
+
+    return true;
+}
+
+void StateRecall::appendChunk (juce::MemoryBlock& state, juce::uint32 tag, const juce::MemoryBlock& payload)
+{
+    juce::MemoryOutputStream output (state, true);
+    output.writeInt (static_cast<int> (tag));
+    output.writeInt (static_cast<int> (payload.getSize()));
+    output.write (payload.getData(), payload.getSize());
+}
+
+bool StateRecall::findChunk (const void* data, size_t sizeInBytes, juce::uint32 tag, juce::MemoryBlock& payload)
+{
+    auto found = false;
+
+    readChunks (data, sizeInBytes, [&] (juce::uint32 chunkTag, juce::MemoryInputStream& input, juce::int64 size)
+    {
+        if (chunkTag == tag)
+        {
+            payload.reset();
+            input.readIntoMemoryBlock (payload, static_cast<ssize_t> (size));
+            found = true;
+        }
+
+        return ! found;
+    });
+
+    return found;
+}
+
+void StateRecall::prepare (bool isRealtime)
+{
+    // The audio thread is stopped, so a pending recall can finish right here;
+    // ParameterEngine::prepare() then starts every ramp at its new value
+    release();
+    m_isLive = isRealtime;
+}
+
+void StateRecall::release()
+{
+    auto phase = m_phase.exchange (idle);
+
+    if (phase == fadeRequested || phase == fadingOut || phase == silent)
+        applyStaged();
+
+    m_isLive = false;
+    m_isAwaitingCoefficients = false;
+
+    if (isTimerRunning())
+        stopTimer();
+}
+
+//==============================================================================
+void StateRecall::beginBlock (ParameterEngine& parameters, const CoefficientWorker& coefficients, bool wetIsSilent) noexcept
+{
+    switch (m_phase.load())
+    {
+        case fadeRequested:
+            m_isAwaitingCoefficients = false;
+
+            if (advance (fadeRequested, fadingOut))
+                parameters.setWetAudible (false);
+            break;
+
+        case fadingOut:
+            if (wetIsSilent || parameters.isWetFadedOut())
+                advance (fadingOut, silent);
+            break;
+
+        // The feedback filter's design lags the parameters by a trip to the worker, so the
+        // wet waits for the design of the recalled values rather than fade in through the
+        // old tone. Only for those: automation that keeps moving the filter afterwards
+        // doesn't hold it up, and neither does a worker that falls behind for long
+        case applied:
+            if (! m_isAwaitingCoefficients)
+            {
+                m_isAwaitingCoefficients = true;
+                m_awaitedGeneration = coefficients.getGeneration();
+                m_blocksAwaited = 0;
+            }
+
+            if ((coefficients.hasBuilt (m_awaitedGeneration) || ++m_blocksAwaited > maxCoefficientWaitBlocks)
+                && advance (applied, idle))
+            {
+                m_isAwaitingCoefficients = false;
+                parameters.jumpToTargets();
+                parameters.setWetAudible (true);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+//==============================================================================
+void StateRecall::timerCallback()
+{
+    auto phase = m_phase.load();
+    auto now = juce::Time::getMillisecondCounter();
+
+    if (phase != m_timedPhase)
+    {
+        m_timedPhase = phase;
+        m_timedPhaseSince = now;
+    }
+
+    // Audio that stopped without a releaseResources() would leave the recall waiting,
+    // so after a while the message thread takes over the fade's part as well
+    auto hasStalled = (phase == fadeRequested || phase == fadingOut) && static_cast<int> (now - m_timedPhaseSince) >= stallTimeoutMs;
+
+    if (phase == silent || (hasStalled && advance (static_cast<Phase> (phase), silent)))
+    {
+        applyStaged();
+        advance (silent, applied);
+
+        // A state read while these values were being set hasn't been applied
+        if (m_staged.load() != nullptr)
+            requestFade();
+    }
+    else if (phase == idle || phase == applied)
+    {
+        stopTimer();
+    }
+}
+
+void StateRecall::stage (const juce::NamedValueSet& values)
+{
+    auto staged = std::make_unique<std::vector<float>> (m_parameters.size());
+
+    for (size_t i = 0; i < m_parameters.size(); ++i)
+    {
+        auto* parameter = m_parameters[i];
+
+        if (auto* value = values.getVarPointer (parameter->paramID))
+            (*staged)[i] = static_cast<float> (*value);
+        else
+            (*staged)[i] = parameter->convertFrom0to1 (parameter->getDefaultValue());
+    }
+
+    // Values staged earlier and not taken yet are superseded; nobody else can be reading them
+    std::unique_ptr<std::vector<float>> superseded (m_staged.exchange (staged.release()));
+}
+
+void StateRecall::applyStaged()
+{
+    // Taken before use, so a readState() on another thread can only stage a new buffer
+    std::unique_ptr<std::vector<float>> staged (m_staged.exchange (nullptr));
+
+    if (staged == nullptr)
+        return;
+
+    for (size_t i = 0; i < m_parameters.size(); ++i)
+    {
+        auto* parameter = m_parameters[i];
+        auto value = parameter->convertTo0to1 ((*staged)[i]);
+
+        if (value != parameter->getValue())
+            parameter->setValueNotifyingHost (value);
+    }
+}
+
+bool StateRecall::advance (Phase from, Phase to) noexcept
+{
+    int expected = from;
+    return m_phase.compare_exchange_strong (expected, to);
+}
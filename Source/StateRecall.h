@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+    StateRecall.h
+    Created: 22 Oct 2026 10:12:31am
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "CoefficientWorker.h"
+#include "ParameterEngine.h"
+
+//==============================================================================
+/**
+    Saves the plugin state in a compact binary format and recalls it without
+    stalling or clicking the audio thread.
+
+    The state is a "FRCT" header with a format version, followed by tagged
+    chunks of { tag, size, payload }, little-endian throughout. A reader skips
+    any chunk it doesn't know, so an older build loads a newer state. The
+    parameter chunk stores every parameter as its ID and its value in the
+    parameter's own units. An unknown ID is ignored, and a parameter missing
+    from the state gets its default, so a state from an older build still
+    recalls exactly. The parameter XML the APVTS writes, which the batch
+    renderer's presets use, is read as well.
+
+    While nothing is playing, a recall sets the parameters straight away,
+    which keeps loading a session with many instances quick. During playback
+    the audio thread first fades the wet path out at a block boundary. The
+    message thread sets the parameters once it is silent, and the audio
+    thread then jumps every ramp to its new value and fades the wet back in.
+    The dry signal is never touched, and the audio thread never waits for
+    anything. If the audio stops partway through, the message thread applies
+    the recall itself.
+
+    Hosts call setStateInformation from whatever thread they like, so
+    readState() never writes anything the message thread reads: it stages the
+    values in a buffer of its own and hands that over with one atomic
+    exchange. The message thread takes the buffer the same way before it
+    applies it, and a state read while another is being applied goes round
+    the fade again.
+*/
+class StateRecall  : private juce::Timer
+{
+public:
+    explicit StateRecall (juce::AudioProcessorValueTreeState& apvts);
+    ~StateRecall() override;
+
+    //==============================================================================
+    // Message thread
+    void writeState (juce::MemoryBlock& destination) const;
+
+    /** Recalls a state from writeState() or parameter XML. Returns false, changing
+        nothing, if the data is neither. Any thread but the audio thread.
+    */
+    bool readState (const void* data, int sizeInBytes);
+
+    /** Reads a state's parameter values, by ID, without applying them. */
+    static bool parse (const void* data, size_t sizeInBytes, juce::NamedValueSet& values);
+
+    /** Writes parameter values, by ID and in the parameters' units, as a state. */
+    static void write (const juce::NamedValueSet& values, juce::MemoryBlock& destination);
+
+    /** Adds a chunk of something other than parameters to a state from writeState(). */
+    static void appendChunk (juce::MemoryBlock& state, juce::uint32 tag, const juce::MemoryBlock& payload);
+
+    /** Copies out the payload of a state's chunk. False if it has no such chunk,
+        or isn't a binary state at all.
+    */
+    static bool findChunk (const void* data, size_t sizeInBytes, juce::uint32 tag, juce::MemoryBlock& payload);
+
+    static constexpr juce::uint32 impulseChunk = 0x52504d49;   // "IMPR": the smear's impulse response file, as UTF-8
+
+    /** Called from prepareToPlay: finishes any pending recall, and from now on
+        recalls fade when realtime and apply at once when not.
+    */
+    void prepare (bool isRealtime);
+
+    /** Called from releaseResources: recalls apply at once until the next prepare(). */
+    void release();
+
+    //==============================================================================
+    /** Audio thread, at the start of every block. Moves a pending recall on by at
+        most one step. wetIsSilent tells it the wet path is silent anyway, as it is
+        while the processor sleeps. Wait-free.
+    */
+    void beginBlock (ParameterEngine& parameters, const CoefficientWorker& coefficients, bool wetIsSilent) noexcept;
+
+private:
+    // Who moves the recall on: the message thread from idle, silent and the
+    // stalled states, the audio thread from the rest
+    enum Phase
+    {
+        idle,
+        fadeRequested,      // staged; waiting for the audio thread to start the fade
+        fadingOut,
+        silent,             // the wet is out; waiting for the message thread to set the parameters
+        applied             // set; waiting for the audio thread to jump the ramps and fade in
+    };
+
+    void timerCallback() override;
+
+    void stage (const juce::NamedValueSet& values);
+    void applyStaged();
+    void requestFade() noexcept;
+    bool advance (Phase from, Phase to) noexcept;
+
+    // Calls visit (tag, stream, size) with the stream at each chunk's payload. False if
+    // the data isn't a binary state, or a chunk runs past the end or visit returns false
+    template <typename Visitor>
+    static bool readChunks (const void* data, size_t sizeInBytes, Visitor&& visit);
+
+    static constexpr juce::uint32 magic = 0x54435246;           // "FRCT"
+    static constexpr juce::uint32 parameterChunk = 0x534d5250;  // "PRMS"
+    static constexpr int formatVersion = 1;
+    static constexpr int timerIntervalMs = 5;
+    static constexpr int stallTimeoutMs = 100;                  // ten times the fade
+    static constexpr int maxCoefficientWaitBlocks = 16;         // then the wet fades in through whatever tone there is
+
+    std::vector<juce::RangedAudioParameter*> m_parameters;
+    std::atomic<std::vector<float>*> m_staged { nullptr };     // owned; the latest values not yet applied, in the parameters' units
+    std::atomic<int> m_phase { idle };
+    bool m_isLive = false;
+    int m_timedPhase = idle;                    // what the timer saw last, and since when
+    juce::uint32 m_timedPhaseSince = 0;
+
+    // Audio thread: the coefficient generation an applied recall waits for, and how long it has
+    bool m_isAwaitingCoefficients = false;
+    juce::uint32 m_awaitedGeneration = 0;
+    int m_blocksAwaited = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (StateRecall)
+};
@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+    TelemetryBus.h
+    Created: 21 Oct 2026 9:02:37am
+    Author:  97252
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/** What the visuals are told about the signal, once per processed block. */
+struct TelemetryFrame
+{
+    static constexpr int numEchoes = 6;     // the source and its first five repeats
+
+    float inputPeak = 0.0f;
+    float outputPeak = 0.0f;
+    float feedbackEnergy = 0.0f;            // mean square of the delayed signal over the last hop
+    float echoLevels[numEchoes] = {};       // peak of the source (0) and of the delayed signal; none in Diffuse
+};
+
+//==============================================================================
+/** Peak and mean square of a signal, gathered a span at a time on the audio thread. */
+struct LevelMeter
+{
+    float peak = 0.0f;
+    double sumOfSquares = 0.0;
+    int numSamples = 0;
+
+    template <typename SampleType>
+    void add (const SampleType* samples, int count) noexcept
+    {
+        if (count <= 0)
+            return;
+
+        auto range = juce::FloatVectorOperations::findMinAndMax (samples, count);
+        SampleType squares = 0;
+
+        for (int i = 0; i < count; ++i)
+            squares += samples[i] * samples[i];
+
+        peak = juce::jmax (peak, static_cast<float> (juce::jmax (-range.getStart(), range.getEnd())));
+        sumOfSquares += static_cast<double> (squares);
+        numSamples += count;
+    }
+
+    void add (const LevelMeter& other) noexcept
+    {
+        peak = juce::jmax (peak, other.peak);
+        sumOfSquares += other.sumOfSquares;
+        numSamples += other.numSamples;
+    }
+
+    float getMeanSquare() const noexcept    { return numSamples > 0 ? static_cast<float> (sumOfSquares / numSamples) : 0.0f; }
+
+    void reset() noexcept                   { *this = {}; }
+};
+
+//==============================================================================
+/**
+    Hands the latest TelemetryFrame from the audio thread to any number of
+    readers without locks.
+
+    It is a sequence lock: the writer makes the sequence odd, stores the
+    frame word by word and makes it even again, so publishing is a fixed
+    handful of relaxed stores and never waits. A reader copies the frame
+    between two loads of the sequence and keeps the copy only when both
+    loads saw the same even value, so it can never use a torn frame. Readers
+    don't write anything, which is why any number of editors can poll the
+    same bus. A reader that keeps losing the race gives up after a few tries
+    rather than spin, and keeps the frame it already has.
+*/
+class TelemetryBus
+{
+public:
+    TelemetryBus() = default;
+
+    /** Audio thread only. Wait-free. */
+    void publish (const TelemetryFrame& frame) noexcept
+    {
+        juce::uint32 words[numWords];
+        std::memcpy (words, &frame, sizeof (frame));
+
+        auto sequence = m_sequence.load (std::memory_order_relaxed);
+        m_sequence.store (sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_release);
+
+        for (int i = 0; i < numWords; ++i)
+            m_words[i].store (words[i], std::memory_order_relaxed);
+
+        m_sequence.store (sequence + 2, std::memory_order_release);
+    }
+
+    /** Any thread. Copies the latest complete frame into destination and
+        returns true, or returns false and leaves destination alone if the
+        writer was mid-publish on every try.
+    */
+    bool read (TelemetryFrame& destination) const noexcept
+    {
+        for (int attempt = 0; attempt < maxReadAttempts; ++attempt)
+        {
+            auto before = m_sequence.load (std::memory_order_acquire);
+
+            if ((before & 1) != 0)
+                continue;
+
+            juce::uint32 words[numWords];
+
+            for (int i = 0; i < numWords; ++i)
+                words[i] = m_words[i].load (std::memory_order_relaxed);
+
+            std::atomic_thread_fence (std::memory_order_acquire);
+
+            if (m_sequence.load (std::memory_order_relaxed) == before)
+            {
+                std::memcpy (&destination, words, sizeof (destination));
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+private:
+    static constexpr int numWords = static_cast<int> (sizeof (TelemetryFrame) / sizeof (juce::uint32));
+    static constexpr int maxReadAttempts = 4;
+
+    static_assert (std::is_trivially_copyable_v<TelemetryFrame> && sizeof (TelemetryFrame) % sizeof (juce::uint32) == 0,
+                   "the frame is copied as whole 32-bit words");
+
+    std::atomic<juce::uint32> m_sequence { 0 };
+    std::atomic<juce::uint32> m_words[numWords] {};
+
+    JUCE_DECLARE_NON_COPYABLE (TelemetryBus)
+};